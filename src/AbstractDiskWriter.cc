@@ -49,6 +49,7 @@
 #include "message.h"
 #include "DlAbortEx.h"
 #include "a2io.h"
+#include "a2netcompat.h"
 #include "fmt.h"
 #include "DownloadFailureException.h"
 #include "error_code.h"
@@ -64,6 +65,7 @@ AbstractDiskWriter::AbstractDiskWriter(const std::string& filename)
 #else  // !__MINGW32__
 #endif // !__MINGW32__
       readOnly_(false),
+      dirty_(false),
       enableMmap_(false),
       mapaddr_(nullptr),
       maplen_(0)
@@ -263,7 +265,9 @@ ssize_t AbstractDiskWriter::writeDataInternal(const unsigned char* data,
   }
   else {
     ssize_t writtenLength = 0;
+#if defined(__MINGW32__) || !defined(HAVE_PWRITE)
     seek(offset);
+#endif // __MINGW32__ || !HAVE_PWRITE
     while ((size_t)writtenLength < len) {
 #ifdef __MINGW32__
       DWORD nwrite;
@@ -276,10 +280,18 @@ ssize_t AbstractDiskWriter::writeDataInternal(const unsigned char* data,
       }
 #else  // !__MINGW32__
       ssize_t ret = 0;
+#  ifdef HAVE_PWRITE
+      // Positioned write saves the lseek() system call per write.
+      while ((ret = a2pwrite(fd_, data + writtenLength, len - writtenLength,
+                             offset + writtenLength)) == -1 &&
+             errno == EINTR)
+        ;
+#  else  // !HAVE_PWRITE
       while ((ret = write(fd_, data + writtenLength, len - writtenLength)) ==
                  -1 &&
              errno == EINTR)
         ;
+#  endif // !HAVE_PWRITE
       if (ret == -1) {
         return -1;
       }
@@ -290,6 +302,45 @@ ssize_t AbstractDiskWriter::writeDataInternal(const unsigned char* data,
   }
 }
 
+#if defined(HAVE_PWRITEV) && !defined(__MINGW32__)
+ssize_t AbstractDiskWriter::writeDataVectorInternal(const DataSegment* segs,
+                                                    size_t segcnt,
+                                                    int64_t offset)
+{
+  ssize_t writtenLength = 0;
+  struct iovec iov[A2_IOV_MAX];
+  // Index of segment and the offset in it to be written next.
+  size_t segidx = 0;
+  size_t segoff = 0;
+  while (segidx < segcnt) {
+    int iovcnt = 0;
+    for (size_t i = segidx; i < segcnt && iovcnt < A2_IOV_MAX; ++i) {
+      size_t skip = i == segidx ? segoff : 0;
+      iov[iovcnt].iov_base = const_cast<unsigned char*>(segs[i].data + skip);
+      iov[iovcnt].iov_len = segs[i].len - skip;
+      ++iovcnt;
+    }
+    ssize_t ret;
+    while ((ret = a2pwritev(fd_, iov, iovcnt, offset + writtenLength)) == -1 &&
+           errno == EINTR)
+      ;
+    if (ret == -1) {
+      return -1;
+    }
+    writtenLength += ret;
+    // Skip the segments written completely.  pwritev() may return
+    // after a partial write.
+    size_t n = ret;
+    for (; segidx < segcnt && n >= segs[segidx].len - segoff; ++segidx) {
+      n -= segs[segidx].len - segoff;
+      segoff = 0;
+    }
+    segoff += n;
+  }
+  return writtenLength;
+}
+#endif // HAVE_PWRITEV && !__MINGW32__
+
 ssize_t AbstractDiskWriter::readDataInternal(unsigned char* data, size_t len,
                                              int64_t offset)
 {
@@ -302,7 +353,9 @@ ssize_t AbstractDiskWriter::readDataInternal(unsigned char* data, size_t len,
     return readlen;
   }
   else {
+#if defined(__MINGW32__) || !defined(HAVE_PREAD)
     seek(offset);
+#endif // __MINGW32__ || !HAVE_PREAD
 #ifdef __MINGW32__
     DWORD nread;
     if (ReadFile(fd_, data, len, &nread, 0)) {
@@ -313,8 +366,13 @@ ssize_t AbstractDiskWriter::readDataInternal(unsigned char* data, size_t len,
     }
 #else  // !__MINGW32__
     ssize_t ret = 0;
+#  ifdef HAVE_PREAD
+    while ((ret = a2pread(fd_, data, len, offset)) == -1 && errno == EINTR)
+      ;
+#  else  // !HAVE_PREAD
     while ((ret = read(fd_, data, len)) == -1 && errno == EINTR)
       ;
+#  endif // !HAVE_PREAD
     return ret;
 #endif // !__MINGW32__
   }
@@ -441,27 +499,54 @@ bool isDiskFullError(int errNum)
 }
 } // namespace
 
+namespace {
+void throwOnWriteError(const std::string& filename, int errNum)
+{
+  // If the error indicates disk full situation, throw
+  // DownloadFailureException and abort download instantly.
+  if (isDiskFullError(errNum)) {
+    throw DOWNLOAD_FAILURE_EXCEPTION3(
+        errNum,
+        fmt(EX_FILE_WRITE, filename.c_str(), fileStrerror(errNum).c_str()),
+        error_code::NOT_ENOUGH_DISK_SPACE);
+  }
+  else {
+    throw DL_ABORT_EX3(
+        errNum,
+        fmt(EX_FILE_WRITE, filename.c_str(), fileStrerror(errNum).c_str()),
+        error_code::FILE_IO_ERROR);
+  }
+}
+} // namespace
+
 void AbstractDiskWriter::writeData(const unsigned char* data, size_t len,
                                    int64_t offset)
 {
   ensureMmapWrite(len, offset);
+  dirty_ = true;
   if (writeDataInternal(data, len, offset) < 0) {
-    int errNum = fileError();
-    // If the error indicates disk full situation, throw
-    // DownloadFailureException and abort download instantly.
-    if (isDiskFullError(errNum)) {
-      throw DOWNLOAD_FAILURE_EXCEPTION3(
-          errNum,
-          fmt(EX_FILE_WRITE, filename_.c_str(), fileStrerror(errNum).c_str()),
-          error_code::NOT_ENOUGH_DISK_SPACE);
-    }
-    else {
-      throw DL_ABORT_EX3(
-          errNum,
-          fmt(EX_FILE_WRITE, filename_.c_str(), fileStrerror(errNum).c_str()),
-          error_code::FILE_IO_ERROR);
+    throwOnWriteError(filename_, fileError());
+  }
+}
+
+void AbstractDiskWriter::writeDataVector(const DataSegment* segs,
+                                         size_t segcnt, int64_t offset)
+{
+#if defined(HAVE_PWRITEV) && !defined(__MINGW32__)
+  size_t len = 0;
+  for (size_t i = 0; i < segcnt; ++i) {
+    len += segs[i].len;
+  }
+  ensureMmapWrite(len, offset);
+  if (!mapaddr_) {
+    dirty_ = true;
+    if (writeDataVectorInternal(segs, segcnt, offset) < 0) {
+      throwOnWriteError(filename_, fileError());
     }
+    return;
   }
+#endif // HAVE_PWRITEV && !__MINGW32__
+  DiskWriter::writeDataVector(segs, segcnt, offset);
 }
 
 ssize_t AbstractDiskWriter::readData(unsigned char* data, size_t len,
@@ -592,14 +677,22 @@ void AbstractDiskWriter::dropCache(int64_t len, int64_t offset)
 
 void AbstractDiskWriter::flushOSBuffers()
 {
-  if (fd_ == A2_BAD_FD) {
+  // Files kept open for seeding are not written any more, and
+  // syncing them on every control file save only adds disk latency
+  // to the event loop.
+  if (fd_ == A2_BAD_FD || !dirty_) {
     return;
   }
+  dirty_ = false;
 #ifdef __MINGW32__
   FlushFileBuffers(fd_);
-#else  // !__MINGW32__
+#elif defined(HAVE_FDATASYNC) && !(defined(__APPLE__) && defined(__MACH__))
+  // We only need file data and its size on disk; skip the timestamp
+  // update fsync() would also force.
+  fdatasync(fd_);
+#else  // !__MINGW32__ && !HAVE_FDATASYNC
   fsync(fd_);
-#endif // __MINGW32__
+#endif // !__MINGW32__ && !HAVE_FDATASYNC
 }
 
 } // namespace aria2
@@ -54,12 +54,19 @@ private:
 
   bool readOnly_;
 
+  // true if data was written after the last flushOSBuffers() call.
+  bool dirty_;
+
   bool enableMmap_;
   unsigned char* mapaddr_;
   int64_t maplen_;
 
   ssize_t writeDataInternal(const unsigned char* data, size_t len,
                             int64_t offset);
+#if defined(HAVE_PWRITEV) && !defined(__MINGW32__)
+  ssize_t writeDataVectorInternal(const DataSegment* segs, size_t segcnt,
+                                  int64_t offset);
+#endif // HAVE_PWRITEV && !__MINGW32__
   ssize_t readDataInternal(unsigned char* data, size_t len, int64_t offset);
 
   void seek(int64_t offset);
@@ -82,6 +89,9 @@ public:
   virtual void writeData(const unsigned char* data, size_t len,
                          int64_t offset) CXX11_OVERRIDE;
 
+  virtual void writeDataVector(const DataSegment* segs, size_t segcnt,
+                               int64_t offset) CXX11_OVERRIDE;
+
   virtual ssize_t readData(unsigned char* data, size_t len,
                            int64_t offset) CXX11_OVERRIDE;
 
@@ -41,6 +41,12 @@
 
 namespace aria2 {
 
+// A buffer passed to BinaryStream::writeDataVector().
+struct DataSegment {
+  const unsigned char* data;
+  size_t len;
+};
+
 class BinaryStream {
 public:
   virtual ~BinaryStream() = default;
@@ -48,6 +54,18 @@ public:
   virtual void writeData(const unsigned char* data, size_t len,
                          int64_t offset) = 0;
 
+  // Writes |segcnt| buffers in |segs| consecutively, starting at
+  // |offset|.  The default implementation calls writeData() for each
+  // buffer.
+  virtual void writeDataVector(const DataSegment* segs, size_t segcnt,
+                               int64_t offset)
+  {
+    for (size_t i = 0; i < segcnt; ++i) {
+      writeData(segs[i].data, segs[i].len, offset);
+      offset += segs[i].len;
+    }
+  }
+
   virtual ssize_t readData(unsigned char* data, size_t len, int64_t offset) = 0;
 
   // Truncates a file to given length. The default implementation does
@@ -157,18 +157,32 @@ bool BitfieldMan::hasMissingPiece(const unsigned char* peerBitfield,
   if (bitfieldLength_ != length) {
     return false;
   }
-  bool retval = false;
-  for (size_t i = 0; i < bitfieldLength_; ++i) {
+  size_t i = 0;
+  // Process 8 bytes at a time.
+  for (; i + sizeof(uint64_t) <= bitfieldLength_; i += sizeof(uint64_t)) {
+    uint64_t peer, have;
+    memcpy(&peer, &peerBitfield[i], sizeof(peer));
+    memcpy(&have, &bitfield_[i], sizeof(have));
+    uint64_t temp = peer & ~have;
+    if (filterEnabled_) {
+      uint64_t filter;
+      memcpy(&filter, &filterBitfield_[i], sizeof(filter));
+      temp &= filter;
+    }
+    if (temp) {
+      return true;
+    }
+  }
+  for (; i < bitfieldLength_; ++i) {
     unsigned char temp = peerBitfield[i] & ~bitfield_[i];
     if (filterEnabled_) {
       temp &= filterBitfield_[i];
     }
     if (temp & 0xffu) {
-      retval = true;
-      break;
+      return true;
     }
   }
-  return retval;
+  return false;
 }
 
 bool BitfieldMan::getFirstMissingUnusedIndex(size_t& index) const
@@ -216,8 +230,18 @@ namespace {
 template <typename Array>
 size_t getStartIndex(size_t index, const Array& bitfield, size_t blocks)
 {
-  while (index < blocks && bitfield::test(bitfield, blocks, index)) {
-    ++index;
+  while (index < blocks) {
+    // Skip a whole byte if all bits in it are set.
+    if (index % 8 == 0 && index + 8 <= blocks &&
+        static_cast<unsigned char>(bitfield[index / 8]) == 0xffu) {
+      index += 8;
+    }
+    else if (bitfield::test(bitfield, blocks, index)) {
+      ++index;
+    }
+    else {
+      break;
+    }
   }
   if (blocks <= index) {
     return blocks;
@@ -232,8 +256,18 @@ namespace {
 template <typename Array>
 size_t getEndIndex(size_t index, const Array& bitfield, size_t blocks)
 {
-  while (index < blocks && !bitfield::test(bitfield, blocks, index)) {
-    ++index;
+  while (index < blocks) {
+    // Skip a whole byte if no bit in it is set.
+    if (index % 8 == 0 && index + 8 <= blocks &&
+        static_cast<unsigned char>(bitfield[index / 8]) == 0) {
+      index += 8;
+    }
+    else if (!bitfield::test(bitfield, blocks, index)) {
+      ++index;
+    }
+    else {
+      break;
+    }
   }
   return index;
 }
@@ -53,6 +53,11 @@ constexpr size_t DEFAULT_MAX_OUTSTANDING_REQUEST = 6;
 // Upper Bound of the number of outstanding request
 constexpr size_t UB_MAX_OUTSTANDING_REQUEST = 256;
 
+// The number of outstanding requests to a peer is sized so that they
+// take this many seconds to be served at the current download speed
+// from the peer.
+constexpr int REQUEST_QUEUE_TIME = 3;
+
 constexpr size_t METADATA_PIECE_SIZE = 16_k;
 
 constexpr const char LPD_MULTICAST_ADDR[] = "239.192.152.143";
@@ -59,8 +59,10 @@
 #include "array_fun.h"
 #include "WrDiskCache.h"
 #include "WrDiskCacheEntry.h"
+#include "RdDiskCache.h"
 #include "DownloadFailureException.h"
 #include "BtRejectMessage.h"
+#include "SmartBan.h"
 
 namespace aria2 {
 
@@ -128,6 +130,8 @@ void BtPieceMessage::doReceivedAction()
                                                      offset);
     }
     piece->completeBlock(slot->getBlockIndex());
+    piece->setBlockContributor(slot->getBlockIndex(),
+                               getPeer()->getIPAddress());
     A2_LOG_DEBUG(fmt(
         MSG_PIECE_BITFIELD, getCuid(),
         util::toHex(piece->getBitfield(), piece->getBitfieldLength()).c_str()));
@@ -135,12 +139,34 @@ void BtPieceMessage::doReceivedAction()
     getBtMessageDispatcher()->removeOutstandingRequest(slot);
     if (piece->pieceComplete()) {
       if (checkPieceHash(piece)) {
+        banCorruptPeers(piece);
         onNewPiece(piece);
       }
       else {
+        const auto& ipaddr = getPeer()->getIPAddress();
+        // The blocks whose contributor is unknown, for example the
+        // ones loaded from a control file, don't clear this peer.
+        bool soleContributor = true;
+        for (size_t i = 0, len = piece->countBlock(); i < len; ++i) {
+          const auto& contributor = piece->getBlockContributor(i);
+          if (!contributor.empty() && contributor != ipaddr) {
+            soleContributor = false;
+            break;
+          }
+        }
+        if (soleContributor) {
+          onWrongPiece(piece);
+          peerStorage_->addBadPeer(ipaddr);
+          throw DL_ABORT_EX("Bad piece hash.");
+        }
+        // Several peers contributed to this piece, and we don't know
+        // which one is to blame yet.
+        A2_LOG_INFO(fmt("CUID#%" PRId64 " - Discarded %" PRId64
+                        " bytes of piece %lu received from several peers",
+                        getCuid(), piece->getLength(),
+                        static_cast<unsigned long>(piece->getIndex())));
+        recordFailedPiece(piece);
         onWrongPiece(piece);
-        peerStorage_->addBadPeer(getPeer()->getIPAddress());
-        throw DL_ABORT_EX("Bad piece hash.");
       }
     }
   }
@@ -218,8 +244,28 @@ void BtPieceMessage::pushPieceData(int64_t offset, int32_t length) const
   auto buf = std::vector<unsigned char>(length + MESSAGE_HEADER_LENGTH);
   createMessageHeader(buf.data());
   ssize_t r;
-  r = getPieceStorage()->getDiskAdaptor()->readData(
-      buf.data() + MESSAGE_HEADER_LENGTH, length, offset);
+  auto rdDiskCache = getPieceStorage()->getRdDiskCache();
+  if (rdDiskCache) {
+    auto diskAdaptor = getPieceStorage()->getDiskAdaptor();
+    int64_t pieceOffset =
+        static_cast<int64_t>(index_) * downloadContext_->getPieceLength();
+    size_t pieceLength = getPieceStorage()->getPieceLength(index_);
+    r = rdDiskCache->readData(diskAdaptor, index_, pieceOffset, pieceLength,
+                              buf.data() + MESSAGE_HEADER_LENGTH, length,
+                              offset);
+    // The last block of the piece has been requested.  The next piece
+    // is likely requested next if the pieces are requested in order.
+    if (r == length && offset + length == pieceOffset + pieceLength &&
+        index_ + 1 < downloadContext_->getNumPieces()) {
+      rdDiskCache->readAhead(diskAdaptor, index_ + 1,
+                             pieceOffset + pieceLength,
+                             getPieceStorage()->getPieceLength(index_ + 1));
+    }
+  }
+  else {
+    r = getPieceStorage()->getDiskAdaptor()->readData(
+        buf.data() + MESSAGE_HEADER_LENGTH, length, offset);
+  }
   if (r == length) {
     const auto& peer = getPeer();
     getPeerConnection()->pushBytes(
@@ -292,6 +338,50 @@ void BtPieceMessage::onWrongPiece(const std::shared_ptr<Piece>& piece)
   getBtRequestFactory()->removeTargetPiece(piece);
 }
 
+void BtPieceMessage::recordFailedPiece(const std::shared_ptr<Piece>& piece)
+{
+  auto smartBan = getPieceStorage()->getSmartBan();
+  if (!smartBan) {
+    return;
+  }
+  try {
+    smartBan->addFailedPiece(
+        *piece,
+        piece->getBlockDigestsWithWrCache(downloadContext_->getPieceLength(),
+                                          getPieceStorage()->getDiskAdaptor()));
+  }
+  catch (RecoverableException& e) {
+    A2_LOG_INFO_EX(fmt("CUID#%" PRId64 " - Could not read blocks of piece %lu",
+                       getCuid(), static_cast<unsigned long>(piece->getIndex())),
+                   e);
+  }
+}
+
+void BtPieceMessage::banCorruptPeers(const std::shared_ptr<Piece>& piece)
+{
+  auto smartBan = getPieceStorage()->getSmartBan();
+  if (!smartBan || !smartBan->hasRecord(piece->getIndex())) {
+    return;
+  }
+  std::vector<std::string> digests;
+  try {
+    digests = piece->getBlockDigestsWithWrCache(
+        downloadContext_->getPieceLength(), getPieceStorage()->getDiskAdaptor());
+  }
+  catch (RecoverableException& e) {
+    A2_LOG_INFO_EX(fmt("CUID#%" PRId64 " - Could not read blocks of piece %lu",
+                       getCuid(), static_cast<unsigned long>(piece->getIndex())),
+                   e);
+  }
+  for (auto& p : smartBan->findCorruptPeers(piece->getIndex(), digests)) {
+    A2_LOG_NOTICE(fmt("Peer %s sent %" PRId64 " bytes of corrupt data in piece"
+                      " %lu. Banned.",
+                      p.first.c_str(), p.second,
+                      static_cast<unsigned long>(piece->getIndex())));
+    peerStorage_->addBadPeer(p.first);
+  }
+}
+
 void BtPieceMessage::onChokingEvent(const BtChokingEvent& event)
 {
   if (!isInvalidate() && !getPeer()->isInAmAllowedIndexSet(index_)) {
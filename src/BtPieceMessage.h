@@ -58,6 +58,14 @@ private:
 
   void onWrongPiece(const std::shared_ptr<Piece>& piece);
 
+  // Remembers the blocks of |piece|, which failed the hash check, so
+  // that the peer which sent corrupt data can be found later.
+  void recordFailedPiece(const std::shared_ptr<Piece>& piece);
+
+  // Bans the peers which sent corrupt blocks of |piece| in the past,
+  // now that it passed the hash check.
+  void banCorruptPeers(const std::shared_ptr<Piece>& piece);
+
   void pushPieceData(int64_t offset, int32_t length) const;
 
 public:
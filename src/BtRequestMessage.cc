@@ -62,9 +62,13 @@ void BtRequestMessage::doReceivedAction()
   if (isMetadataGetMode()) {
     return;
   }
+  // In super seeding mode, only the pieces revealed to the peer are
+  // uploaded.
   if (getPieceStorage()->hasPiece(getIndex()) &&
       (!getPeer()->amChoking() ||
-       getPeer()->isInAmAllowedIndexSet(getIndex()))) {
+       getPeer()->isInAmAllowedIndexSet(getIndex())) &&
+      (!getPeer()->isSuperSeeding() ||
+       getPeer()->isInSuperSeedingIndexSet(getIndex()))) {
     getBtMessageDispatcher()->addMessageToQueue(
         getBtMessageFactory()->createPieceMessage(getIndex(), getBegin(),
                                                   getLength()));
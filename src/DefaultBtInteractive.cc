@@ -35,6 +35,8 @@
 #include "DefaultBtInteractive.h"
 
 #include <cstring>
+#include <algorithm>
+#include <iterator>
 #include <vector>
 
 #include "prefs.h"
@@ -102,7 +104,12 @@ DefaultBtInteractive::DefaultBtInteractive(
       keepAliveInterval_(120),
       utPexEnabled_(false),
       dhtEnabled_(false),
+      superSeeding_(false),
+      superSeedingRevealed_(false),
+      superSeedingIndex_(0),
       numReceivedMessage_(0),
+      sendRedundantHave_(true),
+      numSuppressedHave_(0),
       maxOutstandingRequest_(DEFAULT_MAX_OUTSTANDING_REQUEST),
       requestGroupMan_(nullptr),
       tcpPort_(0)
@@ -175,6 +182,10 @@ void DefaultBtInteractive::doPostHandshakeProcessing()
   keepAliveTimer_ = global::wallclock();
   floodingTimer_ = global::wallclock();
   pexTimer_ = Timer::zero();
+  // Super seeding only makes sense while we have the whole content.
+  superSeeding_ = superSeeding_ && !metadataGetMode_ &&
+                  pieceStorage_->allDownloadFinished();
+  peer_->setSuperSeeding(superSeeding_);
   if (peer_->isExtendedMessagingEnabled()) {
     addHandshakeExtendedMessageToQueue();
   }
@@ -187,6 +198,7 @@ void DefaultBtInteractive::doPostHandshakeProcessing()
   if (!metadataGetMode_) {
     addAllowedFastMessageToQueue();
   }
+  peer_->setMaxOutstandingRequest(maxOutstandingRequest_);
   sendPendingMessage();
 }
 
@@ -212,6 +224,13 @@ void DefaultBtInteractive::addHandshakeExtendedMessageToQueue()
 
 void DefaultBtInteractive::addBitfieldMessageToQueue()
 {
+  if (superSeeding_) {
+    // Pieces are revealed one by one with have messages later.
+    if (peer_->isFastExtensionEnabled()) {
+      dispatcher_->addMessageToQueue(messageFactory_->createHaveNoneMessage());
+    }
+    return;
+  }
   if (peer_->isFastExtensionEnabled()) {
     if (pieceStorage_->allDownloadFinished()) {
       dispatcher_->addMessageToQueue(messageFactory_->createHaveAllMessage());
@@ -262,12 +281,62 @@ void DefaultBtInteractive::decideChoking()
   }
 }
 
+void DefaultBtInteractive::revealSuperSeedingPiece()
+{
+  if (peer_->isSeeder()) {
+    return;
+  }
+  if (superSeedingRevealed_) {
+    // Reveal the next piece only after the peer has downloaded the
+    // last one and it has propagated to another peer, unless this
+    // peer is the only one we are connected to.
+    if (!peer_->hasPiece(superSeedingIndex_) ||
+        (pieceStorage_->getPieceAvailability(superSeedingIndex_) < 2 &&
+         btRuntime_->getConnections() > 1)) {
+      return;
+    }
+  }
+  size_t index;
+  if (pieceStorage_->getSuperSeedingPiece(index, peer_)) {
+    A2_LOG_DEBUG(fmt("CUID#%" PRId64 " - Super seeding: reveal piece %lu",
+                     cuid_, static_cast<unsigned long>(index)));
+    superSeedingRevealed_ = true;
+    superSeedingIndex_ = index;
+    peer_->addSuperSeedingIndex(index);
+    dispatcher_->addMessageToQueue(messageFactory_->createHaveMessage(index));
+  }
+}
+
 void DefaultBtInteractive::checkHave()
 {
   std::vector<size_t> haveIndexes;
 
   lastHaveIndex_ = pieceStorage_->getAdvertisedPieceIndexes(haveIndexes, cuid_,
                                                             lastHaveIndex_);
+  if (haveIndexes.empty()) {
+    return;
+  }
+
+  // The peer does not need the pieces it already has from us, so
+  // these have messages only cost bandwidth.  They are still sent by
+  // default, since the peer may use them for statistics.
+  if (!sendRedundantHave_) {
+    auto last = std::remove_if(
+        std::begin(haveIndexes), std::end(haveIndexes),
+        [this](size_t index) { return peer_->hasPiece(index); });
+    size_t numSuppressed = std::distance(last, std::end(haveIndexes));
+    if (numSuppressed > 0) {
+      haveIndexes.erase(last, std::end(haveIndexes));
+      numSuppressedHave_ += numSuppressed;
+      A2_LOG_DEBUG(fmt("CUID#%" PRId64 " - Suppressed %lu have message(s),"
+                       " total=%lu",
+                       cuid_, static_cast<unsigned long>(numSuppressed),
+                       static_cast<unsigned long>(numSuppressedHave_)));
+      if (haveIndexes.empty()) {
+        return;
+      }
+    }
+  }
 
   // Use bitfield message if it is equal to or less than the total
   // size of have messages.
@@ -343,8 +412,9 @@ size_t DefaultBtInteractive::receiveMessages()
       (countOldOutstandingRequest - dispatcher_->countOutstandingRequest()) *
               4 >=
           maxOutstandingRequest_) {
-    maxOutstandingRequest_ = std::min((size_t)UB_MAX_OUTSTANDING_REQUEST,
-                                      maxOutstandingRequest_ * 2);
+    maxOutstandingRequest_ =
+        std::min(getOutstandingRequestLimit(), maxOutstandingRequest_ * 2);
+    peer_->setMaxOutstandingRequest(maxOutstandingRequest_);
   }
   return msgcount;
 }
@@ -411,6 +481,29 @@ void DefaultBtInteractive::fillPiece(size_t maxMissingBlock)
   }
 }
 
+size_t DefaultBtInteractive::getOutstandingRequestLimit() const
+{
+  size_t reqq = peer_->getReqq();
+  if (reqq > 0) {
+    return std::min((size_t)UB_MAX_OUTSTANDING_REQUEST, reqq);
+  }
+  return UB_MAX_OUTSTANDING_REQUEST;
+}
+
+void DefaultBtInteractive::updateMaxOutstandingRequest()
+{
+  // Keep enough requests in flight to cover REQUEST_QUEUE_TIME
+  // seconds of the current download speed, so that the pipeline does
+  // not drain on high latency links.  The doubling in
+  // receiveMessages() works as a slow start until the download speed
+  // catches up.
+  size_t n = static_cast<int64_t>(peer_->calculateDownloadSpeed()) *
+             REQUEST_QUEUE_TIME / Piece::BLOCK_LENGTH;
+  n = std::max(n, DEFAULT_MAX_OUTSTANDING_REQUEST);
+  maxOutstandingRequest_ = std::min(n, getOutstandingRequestLimit());
+  peer_->setMaxOutstandingRequest(maxOutstandingRequest_);
+}
+
 void DefaultBtInteractive::addRequests()
 {
   if (!pieceStorage_->isEndGame() && !pieceStorage_->hasMissingUnusedPiece()) {
@@ -566,12 +659,18 @@ void DefaultBtInteractive::doInteractionProcessing()
     if (perSecTimer_.difference(global::wallclock()) >= 1_s) {
       perSecTimer_ = global::wallclock();
       dispatcher_->checkRequestSlotAndDoNecessaryThing();
+      updateMaxOutstandingRequest();
     }
     numReceivedMessage_ = receiveMessages();
     detectMessageFlooding();
     decideChoking();
     decideInterest();
-    checkHave();
+    if (superSeeding_) {
+      revealSuperSeedingPiece();
+    }
+    else {
+      checkHave();
+    }
     sendKeepAlive();
     btRequestFactory_->removeCompletedPiece();
     if (!pieceStorage_->downloadFinished()) {
@@ -137,9 +137,22 @@ private:
   std::chrono::seconds keepAliveInterval_;
   bool utPexEnabled_;
   bool dhtEnabled_;
+  bool superSeeding_;
+  // true if a piece has been revealed to the peer in super seeding
+  // mode.  The index of the piece is superSeedingIndex_.
+  bool superSeedingRevealed_;
+  size_t superSeedingIndex_;
 
   size_t numReceivedMessage_;
 
+  // If false, have messages are not sent for the pieces the peer
+  // already has.
+  bool sendRedundantHave_;
+
+  // The number of have messages not sent because the peer already had
+  // the piece.
+  size_t numSuppressedHave_;
+
   size_t maxOutstandingRequest_;
 
   RequestGroupMan* requestGroupMan_;
@@ -150,15 +163,22 @@ private:
   void addAllowedFastMessageToQueue();
   void addHandshakeExtendedMessageToQueue();
   void decideChoking();
-  void checkHave();
   void sendKeepAlive();
   void decideInterest();
   void fillPiece(size_t maxMissingBlock);
   void addRequests();
+  size_t getOutstandingRequestLimit() const;
+  void updateMaxOutstandingRequest();
   void detectMessageFlooding();
   void checkActiveInteraction();
   void addPeerExchangeMessage();
   void addPortMessageToQueue();
+  // Queues have messages for the pieces advertised since the last
+  // call.
+  void checkHave();
+  // Queues a have message for the next piece to reveal to the peer in
+  // super seeding mode, if it is time to reveal one.
+  void revealSuperSeedingPiece();
 
 public:
   DefaultBtInteractive(const std::shared_ptr<DownloadContext>& downloadContext,
@@ -192,6 +212,8 @@ public:
 
   virtual size_t countOutstandingRequest() CXX11_OVERRIDE;
 
+  size_t countSuppressedHave() const { return numSuppressedHave_; }
+
   void setCuid(cuid_t cuid) { cuid_ = cuid; }
 
   void setBtRuntime(const std::shared_ptr<BtRuntime>& btRuntime);
@@ -229,6 +251,10 @@ public:
 
   void setDHTEnabled(bool f) { dhtEnabled_ = f; }
 
+  void setSuperSeeding(bool f) { superSeeding_ = f; }
+
+  void setSendRedundantHave(bool f) { sendRedundantHave_ = f; }
+
   void setRequestGroupMan(RequestGroupMan* rgman);
 
   void setUTMetadataRequestTracker(
@@ -98,6 +98,9 @@ DefaultBtMessageFactory::createBtMessage(const unsigned char* data,
     msg = make_unique<BtKeepAliveMessage>();
   }
   else {
+    // Incoming messages are validated right here with a validator on
+    // the stack instead of attaching a heap-allocated validator to
+    // each message.  This saves one allocation per received message.
     uint8_t id = bittorrent::getId(data);
     switch (id) {
     case BtChokeMessage::ID:
@@ -121,26 +124,26 @@ DefaultBtMessageFactory::createBtMessage(const unsigned char* data,
     case BtHaveMessage::ID:
       msg = BtHaveMessage::create(data, dataLength);
       if (!metadataGetMode_) {
-        msg->setBtMessageValidator(make_unique<IndexBtMessageValidator>(
-            static_cast<BtHaveMessage*>(msg.get()),
-            downloadContext_->getNumPieces()));
+        IndexBtMessageValidator(static_cast<BtHaveMessage*>(msg.get()),
+                                downloadContext_->getNumPieces())
+            .validate();
       }
       break;
     case BtBitfieldMessage::ID:
       msg = BtBitfieldMessage::create(data, dataLength);
       if (!metadataGetMode_) {
-        msg->setBtMessageValidator(make_unique<BtBitfieldMessageValidator>(
-            static_cast<BtBitfieldMessage*>(msg.get()),
-            downloadContext_->getNumPieces()));
+        BtBitfieldMessageValidator(static_cast<BtBitfieldMessage*>(msg.get()),
+                                   downloadContext_->getNumPieces())
+            .validate();
       }
       break;
     case BtRequestMessage::ID: {
       auto m = BtRequestMessage::create(data, dataLength);
       if (!metadataGetMode_) {
-        m->setBtMessageValidator(make_unique<RangeBtMessageValidator>(
-            static_cast<BtRequestMessage*>(m.get()),
-            downloadContext_->getNumPieces(),
-            pieceStorage_->getPieceLength(m->getIndex())));
+        RangeBtMessageValidator(static_cast<BtRequestMessage*>(m.get()),
+                                downloadContext_->getNumPieces(),
+                                pieceStorage_->getPieceLength(m->getIndex()))
+            .validate();
       }
       msg = std::move(m);
       break;
@@ -148,10 +151,10 @@ DefaultBtMessageFactory::createBtMessage(const unsigned char* data,
     case BtPieceMessage::ID: {
       auto m = BtPieceMessage::create(data, dataLength);
       if (!metadataGetMode_) {
-        m->setBtMessageValidator(make_unique<BtPieceMessageValidator>(
-            static_cast<BtPieceMessage*>(m.get()),
-            downloadContext_->getNumPieces(),
-            pieceStorage_->getPieceLength(m->getIndex())));
+        BtPieceMessageValidator(static_cast<BtPieceMessage*>(m.get()),
+                                downloadContext_->getNumPieces(),
+                                pieceStorage_->getPieceLength(m->getIndex()))
+            .validate();
       }
       m->setDownloadContext(downloadContext_);
       m->setPeerStorage(peerStorage_);
@@ -161,10 +164,10 @@ DefaultBtMessageFactory::createBtMessage(const unsigned char* data,
     case BtCancelMessage::ID: {
       auto m = BtCancelMessage::create(data, dataLength);
       if (!metadataGetMode_) {
-        m->setBtMessageValidator(make_unique<RangeBtMessageValidator>(
-            static_cast<BtCancelMessage*>(m.get()),
-            downloadContext_->getNumPieces(),
-            pieceStorage_->getPieceLength(m->getIndex())));
+        RangeBtMessageValidator(static_cast<BtCancelMessage*>(m.get()),
+                                downloadContext_->getNumPieces(),
+                                pieceStorage_->getPieceLength(m->getIndex()))
+            .validate();
       }
       msg = std::move(m);
       break;
@@ -181,9 +184,9 @@ DefaultBtMessageFactory::createBtMessage(const unsigned char* data,
     case BtSuggestPieceMessage::ID: {
       auto m = BtSuggestPieceMessage::create(data, dataLength);
       if (!metadataGetMode_) {
-        m->setBtMessageValidator(make_unique<IndexBtMessageValidator>(
-            static_cast<BtSuggestPieceMessage*>(m.get()),
-            downloadContext_->getNumPieces()));
+        IndexBtMessageValidator(static_cast<BtSuggestPieceMessage*>(m.get()),
+                                downloadContext_->getNumPieces())
+            .validate();
       }
       msg = std::move(m);
       break;
@@ -197,10 +200,10 @@ DefaultBtMessageFactory::createBtMessage(const unsigned char* data,
     case BtRejectMessage::ID: {
       auto m = BtRejectMessage::create(data, dataLength);
       if (!metadataGetMode_) {
-        m->setBtMessageValidator(make_unique<RangeBtMessageValidator>(
-            static_cast<BtRejectMessage*>(m.get()),
-            downloadContext_->getNumPieces(),
-            pieceStorage_->getPieceLength(m->getIndex())));
+        RangeBtMessageValidator(static_cast<BtRejectMessage*>(m.get()),
+                                downloadContext_->getNumPieces(),
+                                pieceStorage_->getPieceLength(m->getIndex()))
+            .validate();
       }
       msg = std::move(m);
       break;
@@ -208,9 +211,9 @@ DefaultBtMessageFactory::createBtMessage(const unsigned char* data,
     case BtAllowedFastMessage::ID: {
       auto m = BtAllowedFastMessage::create(data, dataLength);
       if (!metadataGetMode_) {
-        m->setBtMessageValidator(make_unique<IndexBtMessageValidator>(
-            static_cast<BtAllowedFastMessage*>(m.get()),
-            downloadContext_->getNumPieces()));
+        IndexBtMessageValidator(static_cast<BtAllowedFastMessage*>(m.get()),
+                                downloadContext_->getNumPieces())
+            .validate();
       }
       msg = std::move(m);
       break;
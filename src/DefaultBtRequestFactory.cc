@@ -49,6 +49,7 @@
 #include "array_fun.h"
 #include "fmt.h"
 #include "BtRequestMessage.h"
+#include "SmartBan.h"
 
 namespace aria2 {
 
@@ -163,9 +164,31 @@ void DefaultBtRequestFactory::removeAllTargetPiece()
   pieces_.clear();
 }
 
+void DefaultBtRequestFactory::removeAvoidedPiece()
+{
+  auto smartBan = pieceStorage_->getSmartBan();
+  if (!smartBan || smartBan->countRecord() == 0) {
+    return;
+  }
+  std::vector<std::shared_ptr<Piece>> avoided;
+  for (auto& piece : pieces_) {
+    if (smartBan->avoidPeer(
+            piece->getIndex(), peer_->getIPAddress(),
+            pieceStorage_->getPieceAvailability(piece->getIndex()))) {
+      avoided.push_back(piece);
+    }
+  }
+  for (auto& piece : avoided) {
+    A2_LOG_DEBUG(fmt("CUID#%" PRId64 " - Leave piece %lu to other peers",
+                     cuid_, static_cast<unsigned long>(piece->getIndex())));
+    removeTargetPiece(piece);
+  }
+}
+
 std::vector<std::unique_ptr<BtRequestMessage>>
 DefaultBtRequestFactory::createRequestMessages(size_t max, bool endGame)
 {
+  removeAvoidedPiece();
   if (endGame) {
     return createRequestMessagesOnEndGame(max);
   }
@@ -54,6 +54,10 @@ private:
   std::vector<std::unique_ptr<BtRequestMessage>>
   createRequestMessagesOnEndGame(size_t max);
 
+  // Removes the target pieces which SmartBan tells not to download
+  // from the peer again.
+  void removeAvoidedPiece();
+
   PieceStorage* pieceStorage_;
   std::shared_ptr<Peer> peer_;
   BtMessageDispatcher* dispatcher_;
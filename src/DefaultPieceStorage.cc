@@ -36,6 +36,7 @@
 
 #include <numeric>
 #include <algorithm>
+#include <iterator>
 
 #include "DownloadContext.h"
 #include "Piece.h"
@@ -67,10 +68,12 @@
 #include "SingletonHolder.h"
 #include "Notifier.h"
 #include "WrDiskCache.h"
+#include "RdDiskCache.h"
 #include "RequestGroup.h"
 #include "SimpleRandomizer.h"
 #ifdef ENABLE_BITTORRENT
 #  include "bittorrent_helper.h"
+#  include "SmartBan.h"
 #endif // ENABLE_BITTORRENT
 
 namespace aria2 {
@@ -91,8 +94,10 @@ DefaultPieceStorage::DefaultPieceStorage(
       nextHaveIndex_(1),
       pieceStatMan_(std::make_shared<PieceStatMan>(
           downloadContext->getNumPieces(), true)),
+      localPieceStats_(downloadContext->getNumPieces()),
       pieceSelector_(make_unique<RarestPieceSelector>(pieceStatMan_)),
-      wrDiskCache_(nullptr)
+      wrDiskCache_(nullptr),
+      rdDiskCache_(nullptr)
 {
   const std::string& pieceSelectorOpt =
       option_->get(PREF_STREAM_PIECE_SELECTOR);
@@ -164,24 +169,33 @@ std::shared_ptr<Piece> DefaultPieceStorage::getPiece(size_t index)
 
 void DefaultPieceStorage::addUsedPiece(const std::shared_ptr<Piece>& piece)
 {
-  usedPieces_.insert(piece);
+  usedPieces_.emplace(piece->getIndex(), piece);
   A2_LOG_DEBUG(fmt("usedPieces_.size()=%lu",
                    static_cast<unsigned long>(usedPieces_.size())));
 }
 
 std::shared_ptr<Piece> DefaultPieceStorage::findUsedPiece(size_t index) const
 {
-  auto p = std::make_shared<Piece>();
-  p->setIndex(index);
-
-  auto i = usedPieces_.find(p);
+  auto i = usedPieces_.find(index);
   if (i == usedPieces_.end()) {
-    p.reset();
-    return p;
+    return nullptr;
   }
   else {
-    return *i;
+    return (*i).second;
+  }
+}
+
+std::vector<std::shared_ptr<Piece>>
+DefaultPieceStorage::getSortedUsedPieces() const
+{
+  std::vector<std::shared_ptr<Piece>> pieces;
+  pieces.reserve(usedPieces_.size());
+  for (auto& elem : usedPieces_) {
+    pieces.push_back(elem.second);
   }
+  std::sort(std::begin(pieces), std::end(pieces),
+            DerefLess<std::shared_ptr<Piece>>());
+  return pieces;
 }
 
 #ifdef ENABLE_BITTORRENT
@@ -207,11 +221,8 @@ void DefaultPieceStorage::getMissingPiece(
       return;
     }
     std::vector<size_t> indexes;
-    for (size_t i = 0; i < blocks; ++i) {
-      if (bitfield::test(misbitfield, blocks, i)) {
-        indexes.push_back(i);
-      }
-    }
+    bitfield::getFirstNSetBitIndex(std::back_inserter(indexes), blocks,
+                                   misbitfield.get(), blocks);
     std::shuffle(indexes.begin(), indexes.end(),
                  *SimpleRandomizer::getInstance());
     for (std::vector<size_t>::const_iterator i = indexes.begin(),
@@ -269,10 +280,38 @@ void DefaultPieceStorage::createFastIndexBitfield(
   }
 }
 
+bool DefaultPieceStorage::unsetAvoidedPieces(BitfieldMan& bitfield,
+                                             const std::shared_ptr<Peer>& peer)
+{
+  if (!smartBan_ || smartBan_->countRecord() == 0) {
+    return false;
+  }
+  bool unset = false;
+  for (auto index : smartBan_->findFailedPieces(peer->getIPAddress())) {
+    if (bitfield.isBitSet(index) &&
+        smartBan_->avoidPeer(index, peer->getIPAddress(),
+                             getPieceAvailability(index))) {
+      bitfield.unsetBit(index);
+      unset = true;
+    }
+  }
+  return unset;
+}
+
 void DefaultPieceStorage::getMissingPiece(
     std::vector<std::shared_ptr<Piece>>& pieces, size_t minMissingBlocks,
     const std::shared_ptr<Peer>& peer, cuid_t cuid)
 {
+  if (smartBan_ && smartBan_->countRecord() > 0) {
+    BitfieldMan tempBitfield(bitfieldMan_->getBlockLength(),
+                             bitfieldMan_->getTotalLength());
+    tempBitfield.setBitfield(peer->getBitfield(), peer->getBitfieldLength());
+    if (unsetAvoidedPieces(tempBitfield, peer)) {
+      getMissingPiece(pieces, minMissingBlocks, tempBitfield.getBitfield(),
+                      tempBitfield.getBitfieldLength(), cuid);
+      return;
+    }
+  }
   getMissingPiece(pieces, minMissingBlocks, peer->getBitfield(),
                   peer->getBitfieldLength(), cuid);
 }
@@ -286,6 +325,7 @@ void DefaultPieceStorage::getMissingPiece(
                            bitfieldMan_->getTotalLength());
   tempBitfield.setBitfield(peer->getBitfield(), peer->getBitfieldLength());
   unsetExcludedIndexes(tempBitfield, excludedIndexes);
+  unsetAvoidedPieces(tempBitfield, peer);
   getMissingPiece(pieces, minMissingBlocks, tempBitfield.getBitfield(),
                   tempBitfield.getBitfieldLength(), cuid);
 }
@@ -298,6 +338,7 @@ void DefaultPieceStorage::getMissingFastPiece(
     BitfieldMan tempBitfield(bitfieldMan_->getBlockLength(),
                              bitfieldMan_->getTotalLength());
     createFastIndexBitfield(tempBitfield, peer);
+    unsetAvoidedPieces(tempBitfield, peer);
     getMissingPiece(pieces, minMissingBlocks, tempBitfield.getBitfield(),
                     tempBitfield.getBitfieldLength(), cuid);
   }
@@ -313,6 +354,7 @@ void DefaultPieceStorage::getMissingFastPiece(
                              bitfieldMan_->getTotalLength());
     createFastIndexBitfield(tempBitfield, peer);
     unsetExcludedIndexes(tempBitfield, excludedIndexes);
+    unsetAvoidedPieces(tempBitfield, peer);
     getMissingPiece(pieces, minMissingBlocks, tempBitfield.getBitfield(),
                     tempBitfield.getBitfieldLength(), cuid);
   }
@@ -375,6 +417,46 @@ std::shared_ptr<Piece> DefaultPieceStorage::getMissingFastPiece(
   }
 }
 
+bool DefaultPieceStorage::getSuperSeedingPiece(
+    size_t& index, const std::shared_ptr<Peer>& peer)
+{
+  if (superSeedingRevealCounts_.empty()) {
+    superSeedingRevealCounts_.resize(downloadContext_->getNumPieces());
+  }
+  // The rarest order counts our own pieces, so it is only used to
+  // break ties randomly.
+  bool found = false;
+  size_t best = 0;
+  size_t bestAvail = 0;
+  for (auto i : pieceStatMan_->getRarestOrder()) {
+    if (!hasPiece(i) || peer->hasPiece(i)) {
+      continue;
+    }
+    auto avail = getPieceAvailability(i);
+    if (!found || avail < bestAvail ||
+        (avail == bestAvail &&
+         superSeedingRevealCounts_[i] < superSeedingRevealCounts_[best])) {
+      best = i;
+      bestAvail = avail;
+      found = true;
+    }
+  }
+  if (!found) {
+    return false;
+  }
+  ++superSeedingRevealCounts_[best];
+  index = best;
+  return true;
+}
+
+SmartBan* DefaultPieceStorage::getSmartBan()
+{
+  if (!smartBan_) {
+    smartBan_ = make_unique<SmartBan>();
+  }
+  return smartBan_.get();
+}
+
 #endif // ENABLE_BITTORRENT
 
 bool DefaultPieceStorage::hasMissingUnusedPiece()
@@ -416,7 +498,7 @@ void DefaultPieceStorage::deleteUsedPiece(const std::shared_ptr<Piece>& piece)
   if (!piece) {
     return;
   }
-  usedPieces_.erase(piece);
+  usedPieces_.erase(piece->getIndex());
   piece->releaseWrCache(wrDiskCache_);
 }
 
@@ -471,6 +553,12 @@ void DefaultPieceStorage::completePiece(const std::shared_ptr<Piece>& piece)
   bitfieldMan_->setBit(piece->getIndex());
   bitfieldMan_->unsetUseBit(piece->getIndex());
   addPieceStats(piece->getIndex());
+  ++localPieceStats_[piece->getIndex()];
+  if (rdDiskCache_) {
+    // The piece may have been cached before it was marked missing and
+    // downloaded again.
+    rdDiskCache_->remove(diskAdaptor_, piece->getIndex());
+  }
   if (downloadFinished()) {
     downloadContext_->resetDownloadStopTime();
     if (isSelectiveDownloadingMode()) {
@@ -574,7 +662,7 @@ int64_t DefaultPieceStorage::getInFlightPieceCompletedLength() const
 {
   int64_t len = 0;
   for (auto& elem : usedPieces_) {
-    len += elem->getCompletedLength();
+    len += elem.second->getCompletedLength();
   }
   return len;
 }
@@ -583,8 +671,8 @@ int64_t DefaultPieceStorage::getInFlightPieceFilteredCompletedLength() const
 {
   int64_t len = 0;
   for (auto& elem : usedPieces_) {
-    if (bitfieldMan_->isFilterBitSet(elem->getIndex())) {
-      len += elem->getCompletedLength();
+    if (bitfieldMan_->isFilterBitSet(elem.first)) {
+      len += elem.second->getCompletedLength();
     }
   }
   return len;
@@ -666,6 +754,11 @@ void DefaultPieceStorage::setBitfield(const unsigned char* bitfield,
 {
   bitfieldMan_->setBitfield(bitfield, bitfieldLength);
   addPieceStats(bitfield, bitfieldLength);
+  for (size_t i = 0; i < localPieceStats_.size(); ++i) {
+    if (bitfieldMan_->isBitSet(i)) {
+      ++localPieceStats_[i];
+    }
+  }
 }
 
 size_t DefaultPieceStorage::getBitfieldLength()
@@ -690,10 +783,9 @@ void DefaultPieceStorage::flushWrDiskCacheEntry(bool releaseEntries)
   if (!wrDiskCache_) {
     return;
   }
-  // UsedPieceSet is sorted by piece index. It means we can flush
-  // cache by non-decreasing offset, which is good to reduce disk seek
-  // unless the file is heavily fragmented.
-  for (auto& piece : usedPieces_) {
+  // Flush cache by non-decreasing offset, which is good to reduce
+  // disk seek unless the file is heavily fragmented.
+  for (auto& piece : getSortedUsedPieces()) {
     auto ce = piece->getWrDiskCacheEntry();
     if (ce) {
       piece->flushWrCache(wrDiskCache_);
@@ -790,7 +882,9 @@ void DefaultPieceStorage::markPieceMissing(size_t index)
 void DefaultPieceStorage::addInFlightPiece(
     const std::vector<std::shared_ptr<Piece>>& pieces)
 {
-  usedPieces_.insert(pieces.begin(), pieces.end());
+  for (auto& piece : pieces) {
+    usedPieces_.emplace(piece->getIndex(), piece);
+  }
 }
 
 size_t DefaultPieceStorage::countInFlightPiece() { return usedPieces_.size(); }
@@ -798,7 +892,8 @@ size_t DefaultPieceStorage::countInFlightPiece() { return usedPieces_.size(); }
 void DefaultPieceStorage::getInFlightPieces(
     std::vector<std::shared_ptr<Piece>>& pieces)
 {
-  pieces.insert(pieces.end(), usedPieces_.begin(), usedPieces_.end());
+  auto sorted = getSortedUsedPieces();
+  pieces.insert(pieces.end(), sorted.begin(), sorted.end());
 }
 
 void DefaultPieceStorage::setDiskWriterFactory(
@@ -831,6 +926,12 @@ void DefaultPieceStorage::addPieceStats(size_t index)
   pieceStatMan_->addPieceStats(index);
 }
 
+size_t DefaultPieceStorage::getPieceAvailability(size_t index)
+{
+  return std::max(
+      0, pieceStatMan_->getCounts()[index] - localPieceStats_[index]);
+}
+
 size_t DefaultPieceStorage::getNextUsedIndex(size_t index)
 {
   for (size_t i = index + 1; i < bitfieldMan_->countBlock(); ++i) {
@@ -38,7 +38,7 @@
 #include "PieceStorage.h"
 
 #include <deque>
-#include <set>
+#include <unordered_map>
 
 #include "a2functional.h"
 
@@ -52,6 +52,9 @@ class FileEntry;
 class PieceStatMan;
 class PieceSelector;
 class StreamPieceSelector;
+#ifdef ENABLE_BITTORRENT
+class SmartBan;
+#endif // ENABLE_BITTORRENT
 
 #define END_GAME_PIECE_NUM 20
 
@@ -76,9 +79,9 @@ private:
   std::unique_ptr<BitfieldMan> bitfieldMan_;
   std::shared_ptr<DiskAdaptor> diskAdaptor_;
   std::shared_ptr<DiskWriterFactory> diskWriterFactory_;
-  typedef std::set<std::shared_ptr<Piece>, DerefLess<std::shared_ptr<Piece>>>
-      UsedPieceSet;
-  UsedPieceSet usedPieces_;
+  // In-flight pieces keyed by piece index.
+  typedef std::unordered_map<size_t, std::shared_ptr<Piece>> UsedPieceMap;
+  UsedPieceMap usedPieces_;
 
   bool endGame_;
   size_t endGamePieceNum_;
@@ -91,10 +94,22 @@ private:
 
   std::shared_ptr<PieceStatMan> pieceStatMan_;
 
+  // The number of times our own copy of each piece has been added to
+  // pieceStatMan_.  getPieceAvailability() subtracts it.
+  std::vector<int> localPieceStats_;
+
+  // The number of times each piece has been revealed to peers in
+  // super seeding mode.  Allocated on first use.
+  std::vector<size_t> superSeedingRevealCounts_;
+
   std::unique_ptr<PieceSelector> pieceSelector_;
   std::unique_ptr<StreamPieceSelector> streamPieceSelector_;
 
   WrDiskCache* wrDiskCache_;
+  RdDiskCache* rdDiskCache_;
+#ifdef ENABLE_BITTORRENT
+  std::unique_ptr<SmartBan> smartBan_;
+#endif // ENABLE_BITTORRENT
 #ifdef ENABLE_BITTORRENT
   void getMissingPiece(std::vector<std::shared_ptr<Piece>>& pieces,
                        size_t minMissingBlocks, const unsigned char* bitfield,
@@ -102,6 +117,11 @@ private:
 
   void createFastIndexBitfield(BitfieldMan& bitfield,
                                const std::shared_ptr<Peer>& peer);
+
+  // Unsets the pieces which SmartBan tells not to download from |peer|
+  // again.  Returns true if any bit is unset.
+  bool unsetAvoidedPieces(BitfieldMan& bitfield,
+                          const std::shared_ptr<Peer>& peer);
 #endif // ENABLE_BITTORRENT
 
   std::shared_ptr<Piece> checkOutPiece(size_t index, cuid_t cuid);
@@ -109,6 +129,8 @@ private:
   //   void reduceUsedPieces(size_t upperBound);
   void deleteUsedPiece(const std::shared_ptr<Piece>& piece);
   std::shared_ptr<Piece> findUsedPiece(size_t index) const;
+  // Returns in-flight pieces sorted by index.
+  std::vector<std::shared_ptr<Piece>> getSortedUsedPieces() const;
 
   // Returns the sum of completed length of in-flight pieces
   int64_t getInFlightPieceCompletedLength() const;
@@ -169,6 +191,12 @@ public:
   getMissingFastPiece(const std::shared_ptr<Peer>& peer,
                       const std::vector<size_t>& excludedIndexes, cuid_t cuid);
 
+  virtual bool
+  getSuperSeedingPiece(size_t& index,
+                       const std::shared_ptr<Peer>& peer) CXX11_OVERRIDE;
+
+  virtual SmartBan* getSmartBan() CXX11_OVERRIDE;
+
 #endif // ENABLE_BITTORRENT
 
   virtual bool hasMissingUnusedPiece() CXX11_OVERRIDE;
@@ -234,6 +262,8 @@ public:
 
   virtual WrDiskCache* getWrDiskCache() CXX11_OVERRIDE;
 
+  virtual RdDiskCache* getRdDiskCache() CXX11_OVERRIDE { return rdDiskCache_; }
+
   virtual void flushWrDiskCacheEntry(bool releaseEntries) CXX11_OVERRIDE;
 
   virtual int32_t getPieceLength(size_t index) CXX11_OVERRIDE;
@@ -263,6 +293,8 @@ public:
 
   virtual void addPieceStats(size_t index) CXX11_OVERRIDE;
 
+  virtual size_t getPieceAvailability(size_t index) CXX11_OVERRIDE;
+
   virtual void addPieceStats(const unsigned char* bitfield,
                              size_t bitfieldLength) CXX11_OVERRIDE;
 
@@ -300,6 +332,8 @@ public:
   std::unique_ptr<PieceSelector> popPieceSelector();
 
   void setWrDiskCache(WrDiskCache* wrDiskCache) { wrDiskCache_ = wrDiskCache; }
+
+  void setRdDiskCache(RdDiskCache* rdDiskCache) { rdDiskCache_ = rdDiskCache; }
 };
 
 } // namespace aria2
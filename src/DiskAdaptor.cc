@@ -35,6 +35,9 @@
 #include "DiskAdaptor.h"
 #include "FileEntry.h"
 #include "OpenedFileCounter.h"
+#include "WrDiskCacheEntry.h"
+#include "LogFactory.h"
+#include "fmt.h"
 
 namespace aria2 {
 
@@ -42,4 +45,34 @@ DiskAdaptor::DiskAdaptor() : fileAllocationMethod_(FILE_ALLOC_ADAPTIVE) {}
 
 DiskAdaptor::~DiskAdaptor() = default;
 
+void DiskAdaptor::writeCache(const WrDiskCacheEntry* entry)
+{
+  const auto& dataSet = entry->getDataSet();
+  std::vector<DataSegment> segs;
+  segs.reserve(dataSet.size());
+  int64_t goff = 0;
+  size_t len = 0;
+  for (auto& d : dataSet) {
+    if (!segs.empty() && goff + static_cast<int64_t>(len) != d->goff) {
+      A2_LOG_DEBUG(fmt("Cache flush goff=%" PRId64 ", len=%lu, segs=%lu",
+                       goff, static_cast<unsigned long>(len),
+                       static_cast<unsigned long>(segs.size())));
+      writeDataVector(segs.data(), segs.size(), goff);
+      segs.clear();
+    }
+    if (segs.empty()) {
+      goff = d->goff;
+      len = 0;
+    }
+    segs.push_back(DataSegment{d->data + d->offset, d->len});
+    len += d->len;
+  }
+  if (!segs.empty()) {
+    A2_LOG_DEBUG(fmt("Cache flush goff=%" PRId64 ", len=%lu, segs=%lu", goff,
+                     static_cast<unsigned long>(len),
+                     static_cast<unsigned long>(segs.size())));
+    writeDataVector(segs.data(), segs.size(), goff);
+  }
+}
+
 } // namespace aria2
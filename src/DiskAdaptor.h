@@ -111,8 +111,9 @@ public:
   virtual ssize_t readDataDropCache(unsigned char* data, size_t len,
                                     int64_t offset) = 0;
 
-  // Writes cached data to the underlying disk.
-  virtual void writeCache(const WrDiskCacheEntry* entry) = 0;
+  // Writes cached data to the underlying disk.  Adjacent cells are
+  // coalesced and written by a single writeDataVector() call.
+  virtual void writeCache(const WrDiskCacheEntry* entry);
 
   // Force physical write of data from OS buffer cache.
   virtual void flushOSBuffers(){};
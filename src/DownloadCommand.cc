@@ -35,6 +35,7 @@
 #include "DownloadCommand.h"
 
 #include <cassert>
+#include <algorithm>
 
 #include "Request.h"
 #include "RequestGroup.h"
@@ -73,6 +74,11 @@
 
 namespace aria2 {
 
+namespace {
+constexpr size_t MIN_DIRECT_RECV_SIZE = 16_k;
+constexpr size_t MAX_DIRECT_RECV_SIZE = 256_k;
+} // namespace
+
 DownloadCommand::DownloadCommand(
     cuid_t cuid, const std::shared_ptr<Request>& req,
     const std::shared_ptr<FileEntry>& fileEntry, RequestGroup* requestGroup,
@@ -82,7 +88,8 @@ DownloadCommand::DownloadCommand(
                       socketRecvBuffer),
       startupIdleTime_(10),
       lowestDownloadSpeedLimit_(0),
-      pieceHashValidationEnabled_(false)
+      pieceHashValidationEnabled_(false),
+      directRecvSize_(MIN_DIRECT_RECV_SIZE)
 {
   {
     if (getOption()->getAsBool(PREF_REALTIME_CHUNK_CHECKSUM)) {
@@ -147,7 +154,23 @@ bool DownloadCommand::executeInternal()
       getPieceStorage()->getDiskAdaptor();
   std::shared_ptr<Segment> segment = getSegments().front();
   bool eof = false;
-  if (getSocketRecvBuffer()->bufferEmpty()) {
+  // The length of data we can receive directly into write disk cache.
+  // If it is 0, data goes through SocketRecvBuffer and streamFilter_.
+  size_t directLen = 0;
+  if (sinkFilterOnly_ && segment->getLength() > 0 &&
+      segment->getPiece()->getWrDiskCacheEntry() &&
+      getSocketRecvBuffer()->bufferEmpty()) {
+    directLen = std::min(segment->getLength() - segment->getWrittenLength(),
+                         getFileEntry()->getLastOffset() -
+                             segment->getPositionToWrite());
+  }
+  if (directLen > 0) {
+    auto n = receiveIntoWrDiskCache(segment, directLen);
+    eof = n == 0 && !getSocket()->wantRead() && !getSocket()->wantWrite();
+    peerStat_->updateDownload(n);
+    getDownloadContext()->updateDownload(n);
+  }
+  else if (getSocketRecvBuffer()->bufferEmpty()) {
     // Only read from socket when buffer is empty.  Imagine that When
     // segment length is *short* and we are using HTTP pilelining.  We
     // issued 2 requests in pipeline. When reading first response
@@ -160,7 +183,7 @@ bool DownloadCommand::executeInternal()
     eof = getSocketRecvBuffer()->recv() == 0 && !getSocket()->wantRead() &&
           !getSocket()->wantWrite();
   }
-  if (!eof) {
+  if (!eof && directLen == 0) {
     size_t bufSize;
     if (sinkFilterOnly_) {
       if (segment->getLength() > 0) {
@@ -314,6 +337,48 @@ void DownloadCommand::checkLowestDownloadSpeed() const
   }
 }
 
+size_t
+DownloadCommand::receiveIntoWrDiskCache(const std::shared_ptr<Segment>& segment,
+                                        size_t maxlen)
+{
+  size_t len = std::min(maxlen, directRecvSize_);
+  // Not value-initialized, unlike make_unique.
+  std::unique_ptr<unsigned char[]> buf(new unsigned char[len]);
+  size_t n = len;
+  getSocket()->readData(buf.get(), n);
+  if (n == 0) {
+    return 0;
+  }
+  if (n < len / 2) {
+    // Adopting the mostly empty buffer as a cache cell wastes memory
+    // until the cache is flushed.  Let SinkStreamFilter copy the data
+    // into the existing cell instead.
+    directRecvSize_ = std::max(directRecvSize_ / 2, MIN_DIRECT_RECV_SIZE);
+    streamFilter_->transform(getPieceStorage()->getDiskAdaptor(), segment,
+                             buf.get(), n);
+    return n;
+  }
+  if (n == directRecvSize_) {
+    directRecvSize_ = std::min(directRecvSize_ * 2, MAX_DIRECT_RECV_SIZE);
+  }
+  if (n < len) {
+    // The disk cache only counts the received bytes, so shrink the
+    // buffer rather than pinning the unused part of it.  Full reads,
+    // which are the common case on fast links, need no copy.
+    std::unique_ptr<unsigned char[]> data(new unsigned char[n]);
+    std::copy_n(buf.get(), n, data.get());
+    buf = std::move(data);
+  }
+  if (pieceHashValidationEnabled_) {
+    segment->updateHash(segment->getWrittenLength(), buf.get(), n);
+  }
+  auto goff = segment->getPositionToWrite();
+  segment->getPiece()->updateWrCache(getPieceStorage()->getWrDiskCache(),
+                                     buf.release(), 0, n, n, goff);
+  segment->updateWrittenLength(n);
+  return n;
+}
+
 bool DownloadCommand::prepareForNextSegment()
 {
   if (getRequestGroup()->downloadFinished()) {
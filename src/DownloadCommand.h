@@ -61,6 +61,11 @@ private:
 
   bool sinkFilterOnly_;
 
+  // The number of bytes to receive at once by
+  // receiveIntoWrDiskCache().  Grows while the socket fills the whole
+  // buffer, and shrinks on short reads.
+  size_t directRecvSize_;
+
   void validatePieceHash(const std::shared_ptr<Segment>& segment,
                          const std::string& expectedPieceHash,
                          const std::string& actualPieceHash);
@@ -99,6 +104,15 @@ public:
 
   void installStreamFilter(std::unique_ptr<StreamFilter> streamFilter);
 
+  // Receives at most |maxlen| bytes from socket directly into a new
+  // cell of the write disk cache of |segment|, bypassing
+  // SocketRecvBuffer and SinkStreamFilter.  This must be used only
+  // when sinkFilterOnly_ is true and the piece of |segment| has write
+  // disk cache.  Returns the number of bytes received.  Public for
+  // unit tests.
+  size_t receiveIntoWrDiskCache(const std::shared_ptr<Segment>& segment,
+                                size_t maxlen);
+
   void setStartupIdleTime(std::chrono::seconds startupIdleTime)
   {
     startupIdleTime_ = std::move(startupIdleTime);
@@ -156,6 +156,7 @@ std::unique_ptr<DownloadEngine> DownloadEngineFactory::newDownloadEngine(
     auto requestGroupMan = make_unique<RequestGroupMan>(
         std::move(requestGroups), MAX_CONCURRENT_DOWNLOADS, op);
     requestGroupMan->initWrDiskCache();
+    requestGroupMan->initRdDiskCache();
     e->setRequestGroupMan(std::move(requestGroupMan));
   }
   e->setFileAllocationMan(make_unique<FileAllocationMan>());
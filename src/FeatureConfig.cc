@@ -40,6 +40,12 @@
 #ifdef HAVE_ZLIB
 #  include <zlib.h>
 #endif // HAVE_ZLIB
+#ifdef HAVE_LIBBROTLI
+#  include <brotli/decode.h>
+#endif // HAVE_LIBBROTLI
+#ifdef HAVE_LIBZSTD
+#  include <zstd.h>
+#endif // HAVE_LIBZSTD
 #ifdef HAVE_LIBXML2
 #  include <libxml/xmlversion.h>
 #endif // HAVE_LIBXML2
@@ -194,6 +200,17 @@ std::string usedLibs()
 #ifdef HAVE_ZLIB
   res += "zlib/" ZLIB_VERSION " ";
 #endif // HAVE_ZLIB
+#ifdef HAVE_LIBBROTLI
+  {
+    // No library version in header files.  The version is encoded as
+    // 0xMMMNNNPPP.
+    auto ver = BrotliDecoderVersion();
+    res += fmt("brotli/%u.%u.%u ", ver >> 24, (ver >> 12) & 0xfff, ver & 0xfff);
+  }
+#endif // HAVE_LIBBROTLI
+#ifdef HAVE_LIBZSTD
+  res += "zstd/" ZSTD_VERSION_STRING " ";
+#endif // HAVE_LIBZSTD
 #ifdef HAVE_LIBXML2
   res += "libxml2/" LIBXML_DOTTED_VERSION " ";
 #endif // HAVE_LIBXML2
@@ -52,7 +52,7 @@ namespace aria2 {
 const char HandshakeExtensionMessage::EXTENSION_NAME[] = "handshake";
 
 HandshakeExtensionMessage::HandshakeExtensionMessage()
-    : tcpPort_{0}, metadataSize_{0}, dctx_{nullptr}
+    : tcpPort_{0}, metadataSize_{0}, reqq_{0}, dctx_{nullptr}
 {
 }
 
@@ -76,6 +76,9 @@ std::string HandshakeExtensionMessage::getPayload()
   if (metadataSize_) {
     dict.put("metadata_size", Integer::g(metadataSize_));
   }
+  if (reqq_) {
+    dict.put("reqq", Integer::g(reqq_));
+  }
   return bencode2::encode(&dict);
 }
 
@@ -100,6 +103,9 @@ void HandshakeExtensionMessage::doReceivedAction()
     peer_->setPort(tcpPort_);
     peer_->setIncomingPeer(false);
   }
+  if (reqq_ > 0) {
+    peer_->setReqq(reqq_);
+  }
   for (int i = 0; i < ExtensionMessageRegistry::MAX_EXTENSION; ++i) {
     int id = extreg_.getExtensionMessageID(i);
     if (id) {
@@ -221,6 +227,10 @@ HandshakeExtensionMessage::create(const unsigned char* data, size_t length)
       msg->metadataSize_ = size;
     }
   }
+  const Integer* reqq = downcast<Integer>(dict->get("reqq"));
+  if (reqq && reqq->i() > 0) {
+    msg->reqq_ = reqq->i();
+  }
   return msg;
 }
 
@@ -80,6 +80,12 @@
 #ifdef HAVE_ZLIB
 #  include "GZipDecodingStreamFilter.h"
 #endif // HAVE_ZLIB
+#ifdef HAVE_LIBBROTLI
+#  include "BrotliDecodingStreamFilter.h"
+#endif // HAVE_LIBBROTLI
+#ifdef HAVE_LIBZSTD
+#  include "ZstdDecodingStreamFilter.h"
+#endif // HAVE_LIBZSTD
 
 namespace aria2 {
 
@@ -343,9 +349,24 @@ bool HttpResponseCommand::shouldInflateContentEncoding(
   // files.  I think those files should not be inflated by clients,
   // because it is the original format of those files. Current
   // implementation just inflates these files nonetheless.
+  if (!httpResponse->getHttpRequest()->acceptGZip()) {
+    return false;
+  }
   const std::string& ce = httpResponse->getContentEncoding();
-  return httpResponse->getHttpRequest()->acceptGZip() &&
-         (ce == "gzip" || ce == "deflate");
+  if (ce == "gzip" || ce == "deflate") {
+    return true;
+  }
+#ifdef HAVE_LIBBROTLI
+  if (ce == "br") {
+    return true;
+  }
+#endif // HAVE_LIBBROTLI
+#ifdef HAVE_LIBZSTD
+  if (ce == "zstd") {
+    return true;
+  }
+#endif // HAVE_LIBZSTD
+  return false;
 }
 
 bool HttpResponseCommand::handleDefaultEncoding(
@@ -517,16 +538,26 @@ namespace {
 
 bool decideFileAllocation(StreamFilter* filter)
 {
-#ifdef HAVE_ZLIB
   for (StreamFilter* f = filter; f; f = f->getDelegate().get()) {
     // Since the compressed file's length are returned in the response header
     // and the decompressed file size is unknown at this point, disable file
     // allocation here.
+#ifdef HAVE_ZLIB
     if (f->getName() == GZipDecodingStreamFilter::NAME) {
       return false;
     }
-  }
 #endif // HAVE_ZLIB
+#ifdef HAVE_LIBBROTLI
+    if (f->getName() == BrotliDecodingStreamFilter::NAME) {
+      return false;
+    }
+#endif // HAVE_LIBBROTLI
+#ifdef HAVE_LIBZSTD
+    if (f->getName() == ZstdDecodingStreamFilter::NAME) {
+      return false;
+    }
+#endif // HAVE_LIBZSTD
+  }
 
   return true;
 }
@@ -55,6 +55,8 @@ private:
 
   std::unique_ptr<MessageDigest> ctx_;
 
+  std::unique_ptr<unsigned char[]> buf_;
+
 public:
   IteratableChecksumValidator(
       const std::shared_ptr<DownloadContext>& dctx,
@@ -54,6 +54,7 @@ private:
   std::unique_ptr<BitfieldMan> bitfield_;
   size_t currentIndex_;
   std::unique_ptr<MessageDigest> ctx_;
+  std::unique_ptr<unsigned char[]> buf_;
 
   std::string calculateActualChecksum();
 
@@ -96,6 +96,46 @@ int OpenSSLTLSSession::setSNIHostname(const std::string& hostname)
   return TLS_ERR_OK;
 }
 
+int OpenSSLTLSSession::setSessionData(const std::string& data)
+{
+  ERR_clear_error();
+  auto p = reinterpret_cast<const unsigned char*>(data.data());
+  auto sess = d2i_SSL_SESSION(nullptr, &p, data.size());
+  if (!sess) {
+    return TLS_ERR_ERROR;
+  }
+  // SSL_set_session() takes its own reference.
+  rv_ = SSL_set_session(ssl_, sess);
+  SSL_SESSION_free(sess);
+  if (rv_ != 1) {
+    return TLS_ERR_ERROR;
+  }
+  return TLS_ERR_OK;
+}
+
+std::string OpenSSLTLSSession::getSessionData()
+{
+  auto sess = SSL_get_session(ssl_);
+  if (!sess) {
+    return "";
+  }
+#if !LIBRESSL_IN_USE && OPENSSL_VERSION_NUMBER >= 0x10101000L
+  if (!SSL_SESSION_is_resumable(sess)) {
+    return "";
+  }
+#endif // !LIBRESSL_IN_USE && OPENSSL_VERSION_NUMBER >= 0x10101000L
+  auto len = i2d_SSL_SESSION(sess, nullptr);
+  if (len <= 0) {
+    return "";
+  }
+  std::string data(len, '\0');
+  auto p = reinterpret_cast<unsigned char*>(&data[0]);
+  i2d_SSL_SESSION(sess, &p);
+  return data;
+}
+
+bool OpenSSLTLSSession::isSessionResumed() { return SSL_session_reused(ssl_); }
+
 int OpenSSLTLSSession::closeConnection()
 {
   ERR_clear_error();
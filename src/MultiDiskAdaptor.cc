@@ -50,7 +50,6 @@
 #include "Logger.h"
 #include "LogFactory.h"
 #include "SimpleRandomizer.h"
-#include "WrDiskCacheEntry.h"
 #include "OpenedFileCounter.h"
 
 namespace aria2 {
@@ -410,12 +409,45 @@ ssize_t MultiDiskAdaptor::readData(unsigned char* data, size_t len,
   return totalReadLength;
 }
 
-void MultiDiskAdaptor::writeCache(const WrDiskCacheEntry* entry)
+void MultiDiskAdaptor::writeDataVector(const DataSegment* segs, size_t segcnt,
+                                       int64_t offset)
 {
-  for (auto& d : entry->getDataSet()) {
-    A2_LOG_DEBUG(fmt("Cache flush goff=%" PRId64 ", len=%lu", d->goff,
-                     static_cast<unsigned long>(d->len)));
-    writeData(d->data + d->offset, d->len, d->goff);
+  size_t len = 0;
+  for (size_t i = 0; i < segcnt; ++i) {
+    len += segs[i].len;
+  }
+  auto first = findFirstDiskWriterEntry(diskWriterEntries_, offset);
+  ssize_t rem = len;
+  int64_t fileOffset = offset - (*first)->getFileEntry()->getOffset();
+  // Index of segment and the offset in it to be written next.
+  size_t segidx = 0;
+  size_t segoff = 0;
+  std::vector<DataSegment> fileSegs;
+  for (auto i = first, eoi = diskWriterEntries_.cend(); i != eoi; ++i) {
+    ssize_t writeLength = calculateLength((*i).get(), fileOffset, rem);
+    openIfNot((*i).get(), &DiskWriterEntry::openFile);
+    if (!(*i)->isOpen()) {
+      throwOnDiskWriterNotOpened((*i).get(), offset + (len - rem));
+    }
+    // Slice the segments which belong to this file.
+    fileSegs.clear();
+    for (size_t n = writeLength; n > 0;) {
+      size_t l = std::min(n, segs[segidx].len - segoff);
+      fileSegs.push_back(DataSegment{segs[segidx].data + segoff, l});
+      n -= l;
+      segoff += l;
+      if (segoff == segs[segidx].len) {
+        ++segidx;
+        segoff = 0;
+      }
+    }
+    (*i)->getDiskWriter()->writeDataVector(fileSegs.data(), fileSegs.size(),
+                                           fileOffset);
+    rem -= writeLength;
+    fileOffset = 0;
+    if (rem == 0) {
+      break;
+    }
   }
 }
 
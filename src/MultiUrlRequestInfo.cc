@@ -72,6 +72,7 @@
 #endif // !ENABLE_WEBSOCKET
 #ifdef ENABLE_SSL
 #  include "TLSContext.h"
+#  include "TLSSessionCache.h"
 #endif // ENABLE_SSL
 #ifdef ENABLE_ASYNC_DNS
 #  include "AsyncNameResolver.h"
@@ -270,7 +271,8 @@ int MultiUrlRequestInfo::prepare()
       }
     }
     clTlsContext->setVerifyPeer(option_->getAsBool(PREF_CHECK_CERTIFICATE));
-    SocketCore::setClientTLSContext(clTlsContext);
+    SocketCore::setClientTLSContext(clTlsContext,
+                                    std::make_shared<TLSSessionCache>());
 #endif
 
     std::string serverStatIf = option_->get(PREF_SERVER_STAT_IF);
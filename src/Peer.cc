@@ -308,6 +308,30 @@ void Peer::addAmAllowedIndex(size_t index)
   res_->addAmAllowedIndex(index);
 }
 
+void Peer::setSuperSeeding(bool f)
+{
+  assert(res_);
+  res_->superSeeding(f);
+}
+
+bool Peer::isSuperSeeding() const
+{
+  assert(res_);
+  return res_->superSeeding();
+}
+
+void Peer::addSuperSeedingIndex(size_t index)
+{
+  assert(res_);
+  res_->addSuperSeedingIndex(index);
+}
+
+bool Peer::isInSuperSeedingIndexSet(size_t index) const
+{
+  assert(res_);
+  return res_->superSeedingIndexSetContains(index);
+}
+
 void Peer::setAllBitfield()
 {
   assert(res_);
@@ -359,6 +383,30 @@ bool Peer::isDHTEnabled() const
   return res_->dhtEnabled();
 }
 
+void Peer::setReqq(size_t reqq)
+{
+  assert(res_);
+  res_->reqq(reqq);
+}
+
+size_t Peer::getReqq() const
+{
+  assert(res_);
+  return res_->reqq();
+}
+
+void Peer::setMaxOutstandingRequest(size_t n)
+{
+  assert(res_);
+  res_->maxOutstandingRequest(n);
+}
+
+size_t Peer::getMaxOutstandingRequest() const
+{
+  assert(res_);
+  return res_->maxOutstandingRequest();
+}
+
 const Timer& Peer::getLastDownloadUpdate() const
 {
   assert(res_);
@@ -227,6 +227,16 @@ public:
 
   bool isInAmAllowedIndexSet(size_t index) const;
 
+  // Sets whether localhost is super seeding to this peer.  In super
+  // seeding mode, only the pieces revealed to this peer are uploaded.
+  void setSuperSeeding(bool f);
+
+  bool isSuperSeeding() const;
+
+  void addSuperSeedingIndex(size_t index);
+
+  bool isInSuperSeedingIndexSet(size_t index) const;
+
   void setExtendedMessagingEnabled(bool enabled);
 
   bool isExtendedMessagingEnabled() const;
@@ -235,6 +245,21 @@ public:
 
   bool isDHTEnabled() const;
 
+  // Sets the maximum number of outstanding requests this peer
+  // accepts, which is advertised as "reqq" in the extension
+  // handshake.
+  void setReqq(size_t reqq);
+
+  // Returns the value set by setReqq(), or 0 if the peer did not
+  // advertise it.
+  size_t getReqq() const;
+
+  void setMaxOutstandingRequest(size_t n);
+
+  // Returns the number of requests localhost currently pipelines to
+  // this peer.
+  size_t getMaxOutstandingRequest() const;
+
   bool shouldBeChoking() const;
 
   bool hasPiece(size_t index) const;
@@ -273,6 +273,9 @@ PeerInteractionCommand::PeerInteractionCommand(
   }
 
   btInteractive->setTcpPort(e->getBtRegistry()->getTcpPort());
+  btInteractive->setSuperSeeding(getOption()->getAsBool(PREF_BT_SUPER_SEEDING));
+  btInteractive->setSendRedundantHave(
+      getOption()->getAsBool(PREF_BT_SEND_REDUNDANT_HAVE));
   if (metadataGetMode) {
     btInteractive->enableMetadataGetMode();
   }
@@ -60,7 +60,10 @@ PeerSessionResource::PeerSessionResource(int32_t pieceLength,
       snubbing_(false),
       fastExtensionEnabled_(false),
       extendedMessagingEnabled_(false),
-      dhtEnabled_(false)
+      dhtEnabled_(false),
+      superSeeding_(false),
+      reqq_(0),
+      maxOutstandingRequest_(0)
 {
 }
 
@@ -169,6 +172,18 @@ bool PeerSessionResource::amAllowedIndexSetContains(size_t index) const
   return amAllowedIndexSet_.count(index) == 1;
 }
 
+void PeerSessionResource::superSeeding(bool b) { superSeeding_ = b; }
+
+void PeerSessionResource::addSuperSeedingIndex(size_t index)
+{
+  superSeedingIndexSet_.insert(index);
+}
+
+bool PeerSessionResource::superSeedingIndexSetContains(size_t index) const
+{
+  return superSeedingIndexSet_.count(index) == 1;
+}
+
 void PeerSessionResource::extendedMessagingEnabled(bool b)
 {
   extendedMessagingEnabled_ = b;
@@ -191,6 +206,13 @@ void PeerSessionResource::addExtension(int key, uint8_t id)
 
 void PeerSessionResource::dhtEnabled(bool b) { dhtEnabled_ = b; }
 
+void PeerSessionResource::reqq(size_t n) { reqq_ = n; }
+
+void PeerSessionResource::maxOutstandingRequest(size_t n)
+{
+  maxOutstandingRequest_ = n;
+}
+
 int64_t PeerSessionResource::uploadLength() const
 {
   return netStat_.getSessionUploadLength();
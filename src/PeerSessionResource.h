@@ -58,6 +58,9 @@ private:
   std::set<size_t> peerAllowedIndexSet_;
   // fast index set which localhost has sent to a peer.
   std::set<size_t> amAllowedIndexSet_;
+  // index set which localhost has revealed to a peer in super seeding
+  // mode.
+  std::set<size_t> superSeedingIndexSet_;
   ExtensionMessageRegistry extreg_;
   NetStat netStat_;
 
@@ -84,6 +87,14 @@ private:
   bool fastExtensionEnabled_;
   bool extendedMessagingEnabled_;
   bool dhtEnabled_;
+  // localhost is super seeding to this peer.
+  bool superSeeding_;
+  // The number of outstanding requests the peer accepts, advertised
+  // as "reqq" in the extension handshake.  0 if not advertised.
+  size_t reqq_;
+  // The number of outstanding requests localhost currently allows
+  // itself to have to this peer.
+  size_t maxOutstandingRequest_;
 
 public:
   PeerSessionResource(int32_t pieceLength, int64_t totalLength);
@@ -164,6 +175,17 @@ public:
 
   bool amAllowedIndexSetContains(size_t index) const;
 
+  // localhost is super seeding to this peer.
+  bool superSeeding() const { return superSeeding_; }
+
+  void superSeeding(bool b);
+
+  // index set which localhost has revealed to a peer in super seeding
+  // mode.
+  void addSuperSeedingIndex(size_t index);
+
+  bool superSeedingIndexSetContains(size_t index) const;
+
   bool extendedMessagingEnabled() const { return extendedMessagingEnabled_; }
 
   void extendedMessagingEnabled(bool b);
@@ -178,6 +200,14 @@ public:
 
   void dhtEnabled(bool b);
 
+  size_t reqq() const { return reqq_; }
+
+  void reqq(size_t n);
+
+  size_t maxOutstandingRequest() const { return maxOutstandingRequest_; }
+
+  void maxOutstandingRequest(size_t n);
+
   NetStat& getNetStat() { return netStat_; }
 
   int64_t uploadLength() const;
@@ -34,8 +34,9 @@
 /* copyright --> */
 #include "Piece.h"
 
-#include <array>
 #include <cassert>
+#include <cstring>
+#include <vector>
 
 #include "util.h"
 #include "BitfieldMan.h"
@@ -74,6 +75,7 @@ void Piece::clearAllBlock(WrDiskCache* diskCache)
 {
   bitfield_->clearAllBit();
   bitfield_->clearAllUseBit();
+  blockContributors_.clear();
   if (diskCache && wrCache_) {
     clearWrCache(diskCache);
   }
@@ -226,26 +228,31 @@ std::string Piece::getDigest()
 }
 
 namespace {
+// The maximum number of bytes read from disk at once to calculate the
+// hash of a piece.  Reading a 4MiB piece in 4KiB chunks took 1024
+// system calls.
+constexpr size_t HASH_READ_BUFSIZE = 256_k;
+
 void updateHashWithRead(MessageDigest* mdctx,
                         const std::shared_ptr<DiskAdaptor>& adaptor,
-                        int64_t offset, size_t len)
+                        std::vector<unsigned char>& buf, int64_t offset,
+                        size_t len)
 {
-  std::array<unsigned char, 4_k> buf;
-  ldiv_t res = ldiv(len, buf.size());
-  for (int j = 0; j < res.quot; ++j) {
-    ssize_t nread = adaptor->readData(buf.data(), buf.size(), offset);
-    if ((size_t)nread != buf.size()) {
-      throw DL_ABORT_EX(fmt(EX_FILE_READ, "n/a", "data is too short"));
-    }
-    mdctx->update(buf.data(), nread);
-    offset += nread;
+  if (len == 0) {
+    return;
   }
-  if (res.rem) {
-    ssize_t nread = adaptor->readData(buf.data(), res.rem, offset);
-    if (nread != res.rem) {
+  if (buf.empty()) {
+    buf.resize(std::min(len, HASH_READ_BUFSIZE));
+  }
+  while (len) {
+    size_t n = std::min(len, buf.size());
+    ssize_t nread = adaptor->readData(buf.data(), n, offset);
+    if ((size_t)nread != n) {
       throw DL_ABORT_EX(fmt(EX_FILE_READ, "n/a", "data is too short"));
     }
     mdctx->update(buf.data(), nread);
+    offset += nread;
+    len -= nread;
   }
 }
 } // namespace
@@ -257,23 +264,81 @@ Piece::getDigestWithWrCache(size_t pieceLength,
   auto mdctx = MessageDigest::create(hashType_);
   int64_t start = static_cast<int64_t>(index_) * pieceLength;
   int64_t goff = start;
+  // Allocated on first disk read; not needed if the whole piece is
+  // still in the write cache.
+  std::vector<unsigned char> buf;
   if (wrCache_) {
     const WrDiskCacheEntry::DataCellSet& dataSet = wrCache_->getDataSet();
     for (auto& d : dataSet) {
       if (goff < d->goff) {
-        updateHashWithRead(mdctx.get(), adaptor, goff, d->goff - goff);
+        updateHashWithRead(mdctx.get(), adaptor, buf, goff, d->goff - goff);
       }
       mdctx->update(d->data + d->offset, d->len);
       goff = d->goff + d->len;
     }
-    updateHashWithRead(mdctx.get(), adaptor, goff, start + length_ - goff);
+    updateHashWithRead(mdctx.get(), adaptor, buf, goff,
+                       start + length_ - goff);
   }
   else {
-    updateHashWithRead(mdctx.get(), adaptor, goff, length_);
+    updateHashWithRead(mdctx.get(), adaptor, buf, goff, length_);
   }
   return mdctx->digest();
 }
 
+std::vector<std::string>
+Piece::getBlockDigestsWithWrCache(size_t pieceLength,
+                                  const std::shared_ptr<DiskAdaptor>& adaptor)
+{
+  int64_t start = static_cast<int64_t>(index_) * pieceLength;
+  std::vector<unsigned char> data(length_);
+  auto readData = [&](int64_t goff, size_t len) {
+    if (len > 0 &&
+        static_cast<size_t>(adaptor->readData(data.data() + (goff - start),
+                                              len, goff)) != len) {
+      throw DL_ABORT_EX(fmt(EX_FILE_READ, "n/a", "data is too short"));
+    }
+  };
+  int64_t goff = start;
+  if (wrCache_) {
+    for (auto& d : wrCache_->getDataSet()) {
+      if (goff < d->goff) {
+        readData(goff, d->goff - goff);
+      }
+      memcpy(data.data() + (d->goff - start), d->data + d->offset, d->len);
+      goff = d->goff + d->len;
+    }
+  }
+  readData(goff, start + length_ - goff);
+
+  std::vector<std::string> digests;
+  auto mdctx = MessageDigest::sha1();
+  size_t off = 0;
+  for (size_t i = 0, len = countBlock(); i < len; ++i) {
+    size_t blockLength = getBlockLength(i);
+    mdctx->reset();
+    mdctx->update(data.data() + off, blockLength);
+    digests.push_back(mdctx->digest());
+    off += blockLength;
+  }
+  return digests;
+}
+
+void Piece::setBlockContributor(size_t blockIndex, const std::string& ipaddr)
+{
+  if (blockContributors_.empty()) {
+    blockContributors_.resize(countBlock());
+  }
+  blockContributors_[blockIndex] = ipaddr;
+}
+
+const std::string& Piece::getBlockContributor(size_t blockIndex) const
+{
+  if (blockContributors_.empty()) {
+    return A2STR::NIL;
+  }
+  return blockContributors_[blockIndex];
+}
+
 void Piece::destroyHashContext()
 {
   mdctx_.reset();
@@ -59,6 +59,9 @@ private:
   std::unique_ptr<WrDiskCacheEntry> wrCache_;
   std::unique_ptr<MessageDigest> mdctx_;
   std::vector<cuid_t> users_;
+  // IP address of the peer which sent each block.  Allocated on first
+  // use.
+  std::vector<std::string> blockContributors_;
   std::string hashType_;
 
   size_t index_;
@@ -162,6 +165,20 @@ public:
   // cached data and data on disk.
   std::string getDigestWithWrCache(size_t pieceLength,
                                    const std::shared_ptr<DiskAdaptor>& adaptor);
+
+  // Returns SHA-1 digest of each block, calculated using cached data
+  // and data on disk.
+  std::vector<std::string>
+  getBlockDigestsWithWrCache(size_t pieceLength,
+                             const std::shared_ptr<DiskAdaptor>& adaptor);
+
+  // Remembers that the block at |blockIndex| was sent by the peer at
+  // |ipaddr|.  Used to find the peer which sent corrupt data.
+  void setBlockContributor(size_t blockIndex, const std::string& ipaddr);
+
+  // Returns the IP address given by setBlockContributor(), or empty
+  // string if it is unknown.
+  const std::string& getBlockContributor(size_t blockIndex) const;
   /**
    * Loses current bitfield state.
    */
@@ -43,7 +43,10 @@
 namespace aria2 {
 
 PieceStatMan::PieceStatMan(size_t pieceNum, bool randomShuffle)
-    : order_(pieceNum), counts_(pieceNum)
+    : order_(pieceNum),
+      counts_(pieceNum),
+      pos_(pieceNum),
+      bucketStart_{0, pieceNum}
 {
   for (size_t i = 0; i < pieceNum; ++i) {
     order_[i] = i;
@@ -53,34 +56,61 @@ PieceStatMan::PieceStatMan(size_t pieceNum, bool randomShuffle)
     std::shuffle(order_.begin(), order_.end(),
                  *SimpleRandomizer::getInstance());
   }
+  sorted_ = order_;
+  for (size_t i = 0; i < pieceNum; ++i) {
+    pos_[sorted_[i]] = i;
+  }
 }
 
 PieceStatMan::~PieceStatMan() = default;
 
-namespace {
-void inc(int& x)
+void PieceStatMan::swapPosition(size_t index, size_t pos)
+{
+  size_t other = sorted_[pos];
+  sorted_[pos_[index]] = other;
+  pos_[other] = pos_[index];
+  sorted_[pos] = index;
+  pos_[index] = pos;
+}
+
+void PieceStatMan::inc(size_t index)
 {
-  if (x < std::numeric_limits<int>::max()) {
-    ++x;
+  int c = counts_[index];
+  if (c == std::numeric_limits<int>::max()) {
+    return;
+  }
+  if (bucketStart_.size() < static_cast<size_t>(c) + 3) {
+    bucketStart_.push_back(counts_.size());
   }
+  // Move the piece to the last position of its bucket, and shrink
+  // the bucket by one so that the piece falls into the next one.
+  swapPosition(index, --bucketStart_[c + 1]);
+  ++counts_[index];
 }
-} // namespace
 
-namespace {
-void sub(int& x)
+void PieceStatMan::sub(size_t index)
 {
-  if (x > 0) {
-    --x;
+  int c = counts_[index];
+  if (c == 0) {
+    return;
   }
+  swapPosition(index, bucketStart_[c]++);
+  --counts_[index];
 }
-} // namespace
 
 void PieceStatMan::addPieceStats(const unsigned char* bitfield,
                                  size_t bitfieldLength)
 {
-  for (size_t i = 0, nbits = counts_.size(); i < nbits; ++i) {
-    if (bitfield::test(bitfield, nbits, i)) {
-      inc(counts_[i]);
+  size_t nbits = counts_.size();
+  bitfieldLength = std::min(bitfieldLength, (nbits + 7) / 8);
+  for (size_t i = 0; i < bitfieldLength; ++i) {
+    if (bitfield[i] == 0) {
+      continue;
+    }
+    for (size_t j = 0, idx = i * 8; j < 8 && idx < nbits; ++j, ++idx) {
+      if (bitfield[i] & (0x80u >> j)) {
+        inc(idx);
+      }
     }
   }
 }
@@ -88,9 +118,16 @@ void PieceStatMan::addPieceStats(const unsigned char* bitfield,
 void PieceStatMan::subtractPieceStats(const unsigned char* bitfield,
                                       size_t bitfieldLength)
 {
-  for (size_t i = 0, nbits = counts_.size(); i < nbits; ++i) {
-    if (bitfield::test(bitfield, nbits, i)) {
-      sub(counts_[i]);
+  size_t nbits = counts_.size();
+  bitfieldLength = std::min(bitfieldLength, (nbits + 7) / 8);
+  for (size_t i = 0; i < bitfieldLength; ++i) {
+    if (bitfield[i] == 0) {
+      continue;
+    }
+    for (size_t j = 0, idx = i * 8; j < 8 && idx < nbits; ++j, ++idx) {
+      if (bitfield[i] & (0x80u >> j)) {
+        sub(idx);
+      }
     }
   }
 }
@@ -99,20 +136,28 @@ void PieceStatMan::updatePieceStats(const unsigned char* newBitfield,
                                     size_t newBitfieldLength,
                                     const unsigned char* oldBitfield)
 {
-  for (size_t i = 0, nbits = counts_.size(); i < nbits; ++i) {
-    bool inNew = bitfield::test(newBitfield, nbits, i);
-    bool inOld = bitfield::test(oldBitfield, nbits, i);
-    if (inNew) {
-      if (!inOld) {
-        inc(counts_[i]);
-      }
+  size_t nbits = counts_.size();
+  size_t len = std::min(newBitfieldLength, (nbits + 7) / 8);
+  for (size_t i = 0; i < len; ++i) {
+    // Only look at the bits which differ.
+    unsigned char diff = newBitfield[i] ^ oldBitfield[i];
+    if (diff == 0) {
+      continue;
     }
-    else if (inOld) {
-      sub(counts_[i]);
+    for (size_t j = 0, idx = i * 8; j < 8 && idx < nbits; ++j, ++idx) {
+      unsigned char mask = 0x80u >> j;
+      if (diff & mask) {
+        if (newBitfield[i] & mask) {
+          inc(idx);
+        }
+        else {
+          sub(idx);
+        }
+      }
     }
   }
 }
 
-void PieceStatMan::addPieceStats(size_t index) { inc(counts_[index]); }
+void PieceStatMan::addPieceStats(size_t index) { inc(index); }
 
 } // namespace aria2
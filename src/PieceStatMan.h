@@ -45,6 +45,20 @@ class PieceStatMan {
 private:
   std::vector<size_t> order_;
   std::vector<int> counts_;
+  // Piece indices sorted by counts_ in ascending order.  Pieces with
+  // the same count are initially in the order of order_.
+  std::vector<size_t> sorted_;
+  // pos_[i] is the position of piece i in sorted_.
+  std::vector<size_t> pos_;
+  // The pieces whose count is c are stored in sorted_ in the range
+  // [bucketStart_[c], bucketStart_[c + 1]).
+  std::vector<size_t> bucketStart_;
+
+  void inc(size_t index);
+
+  void sub(size_t index);
+
+  void swapPosition(size_t index, size_t pos);
 
 public:
   PieceStatMan(size_t pieceNum, bool randomShuffle);
@@ -64,6 +78,11 @@ public:
   const std::vector<size_t>& getOrder() const { return order_; }
 
   const std::vector<int>& getCounts() const { return counts_; }
+
+  // Returns piece indices sorted by count in ascending order.  This
+  // is maintained incrementally, so the cost of updating stats is
+  // proportional to the number of changed pieces.
+  const std::vector<size_t>& getRarestOrder() const { return sorted_; }
 };
 
 } // namespace aria2
@@ -49,9 +49,11 @@ namespace aria2 {
 class Piece;
 #ifdef ENABLE_BITTORRENT
 class Peer;
+class SmartBan;
 #endif // ENABLE_BITTORRENT
 class DiskAdaptor;
 class WrDiskCache;
+class RdDiskCache;
 
 class PieceStorage {
 public:
@@ -124,6 +126,18 @@ public:
   virtual std::shared_ptr<Piece>
   getMissingPiece(const std::shared_ptr<Peer>& peer,
                   const std::vector<size_t>& excludedIndexes, cuid_t cuid) = 0;
+
+  // Stores the index of the piece to reveal to the peer next in super
+  // seeding mode in |index|.  The piece is chosen among the pieces
+  // localhost has but the peer doesn't.  The rarest piece is
+  // preferred, and among equally rare ones the piece revealed to the
+  // fewest peers so far.  Returns true if such a piece is found.
+  virtual bool getSuperSeedingPiece(size_t& index,
+                                    const std::shared_ptr<Peer>& peer) = 0;
+
+  // Returns the object which remembers the blocks of the pieces which
+  // failed the hash check, or nullptr if it is not supported.
+  virtual SmartBan* getSmartBan() = 0;
 #endif // ENABLE_BITTORRENT
 
   // Returns true if there is at least one missing and unused piece.
@@ -226,6 +240,10 @@ public:
 
   virtual WrDiskCache* getWrDiskCache() = 0;
 
+  // Returns the cache used to read pieces for upload, or nullptr if
+  // it is disabled.
+  virtual RdDiskCache* getRdDiskCache() = 0;
+
   // Flushes write disk cache for in-flight piece
   // and optionally releases the associated cache entries.
   virtual void flushWrDiskCacheEntry(bool releaseEntries) = 0;
@@ -273,6 +291,10 @@ public:
 
   virtual void addPieceStats(size_t index) = 0;
 
+  // Returns the number of connected peers which have the piece
+  // |index|.
+  virtual size_t getPieceAvailability(size_t index) = 0;
+
   virtual void addPieceStats(const unsigned char* bitfield,
                              size_t bitfieldLength) = 0;
 
@@ -34,9 +34,6 @@
 /* copyright --> */
 #include "RarestPieceSelector.h"
 
-#include <limits>
-#include <algorithm>
-
 #include "PieceStatMan.h"
 #include "bitfield.h"
 
@@ -51,24 +48,14 @@ RarestPieceSelector::RarestPieceSelector(
 bool RarestPieceSelector::select(size_t& index, const unsigned char* bitfield,
                                  size_t nbits) const
 {
-  const std::vector<size_t>& order = pieceStatMan_->getOrder();
-  const std::vector<int>& counts = pieceStatMan_->getCounts();
-  int min = std::numeric_limits<int>::max();
-  size_t bestIdx = nbits;
-  for (size_t i = 0; i < nbits; ++i) {
-    size_t idx = order[i];
-    if (bitfield::test(bitfield, nbits, idx) && counts[idx] < min) {
-      min = counts[idx];
-      bestIdx = idx;
+  // The first piece found in the rarest order has the minimum count.
+  for (auto idx : pieceStatMan_->getRarestOrder()) {
+    if (bitfield::test(bitfield, nbits, idx)) {
+      index = idx;
+      return true;
     }
   }
-  if (bestIdx == nbits) {
-    return false;
-  }
-  else {
-    index = bestIdx;
-    return true;
-  }
+  return false;
 }
 
 } // namespace aria2
@@ -0,0 +1,168 @@
+/* <!-- copyright */
+/*
+ * aria2 - The high speed download utility
+ *
+ * Copyright (C) 2012 Tatsuhiro Tsujikawa
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * In addition, as a special exception, the copyright holders give
+ * permission to link the code of portions of this program with the
+ * OpenSSL library under certain conditions as described in each
+ * individual source file, and distribute linked combinations
+ * including the two.
+ * You must obey the GNU General Public License in all respects
+ * for all of the code used other than OpenSSL.  If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so.  If you
+ * do not wish to do so, delete this exception statement from your
+ * version.  If you delete this exception statement from all source
+ * files in the program, then also delete it here.
+ */
+/* copyright --> */
+#include "RdDiskCache.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "DiskAdaptor.h"
+#include "LogFactory.h"
+#include "fmt.h"
+#include "a2functional.h"
+
+namespace aria2 {
+
+RdDiskCache::RdDiskCache(int64_t limit)
+    : limit_(limit),
+      total_(0),
+      hits_(0),
+      misses_(0),
+      evictions_(0),
+      readAheads_(0)
+{
+}
+
+RdDiskCache::~RdDiskCache()
+{
+  A2_LOG_INFO(fmt("Read disk cache hits=%" PRIu64 ", misses=%" PRIu64
+                  ", evictions=%" PRIu64 ", read-aheads=%" PRIu64,
+                  hits_, misses_, evictions_, readAheads_));
+}
+
+ssize_t RdDiskCache::readData(const std::shared_ptr<DiskAdaptor>& adaptor,
+                              size_t index, int64_t pieceOffset,
+                              size_t pieceLength, unsigned char* data,
+                              size_t len, int64_t offset)
+{
+  assert(pieceOffset <= offset);
+  assert(offset + static_cast<int64_t>(len) <=
+         pieceOffset + static_cast<int64_t>(pieceLength));
+  auto i = find(adaptor, index);
+  if (i != std::end(index_)) {
+    auto ent = (*i).second;
+    ++hits_;
+    entries_.splice(std::begin(entries_), entries_, ent);
+    memcpy(data, (*ent).data.get() + (offset - pieceOffset), len);
+    return len;
+  }
+  ++misses_;
+  if (static_cast<int64_t>(pieceLength) > limit_) {
+    return adaptor->readData(data, len, offset);
+  }
+  auto ent = load(adaptor, index, pieceOffset, pieceLength);
+  if (!ent) {
+    // Don't cache partial piece.  Let the caller see the short read.
+    return adaptor->readData(data, len, offset);
+  }
+  memcpy(data, ent->data.get() + (offset - pieceOffset), len);
+  return len;
+}
+
+void RdDiskCache::readAhead(const std::shared_ptr<DiskAdaptor>& adaptor,
+                            size_t index, int64_t pieceOffset,
+                            size_t pieceLength)
+{
+  if (index < 2 || static_cast<int64_t>(pieceLength) > limit_ / 2 ||
+      find(adaptor, index) != std::end(index_) ||
+      find(adaptor, index - 1) == std::end(index_) ||
+      find(adaptor, index - 2) == std::end(index_)) {
+    return;
+  }
+  if (load(adaptor, index, pieceOffset, pieceLength)) {
+    A2_LOG_DEBUG(fmt("Read ahead piece index=%lu",
+                     static_cast<unsigned long>(index)));
+    ++readAheads_;
+  }
+}
+
+RdDiskCache::EntryMap::iterator
+RdDiskCache::find(const std::shared_ptr<DiskAdaptor>& adaptor, size_t index)
+{
+  auto i = index_.find(std::make_pair(adaptor.get(), index));
+  if (i != std::end(index_) && (*(*i).second).adaptor.lock() != adaptor) {
+    erase(i);
+    return std::end(index_);
+  }
+  return i;
+}
+
+RdDiskCache::Entry*
+RdDiskCache::load(const std::shared_ptr<DiskAdaptor>& adaptor, size_t index,
+                  int64_t pieceOffset, size_t pieceLength)
+{
+  auto buf = make_unique<unsigned char[]>(pieceLength);
+  ssize_t r = adaptor->readData(buf.get(), pieceLength, pieceOffset);
+  if (r != static_cast<ssize_t>(pieceLength)) {
+    return nullptr;
+  }
+  auto key = std::make_pair(adaptor.get(), index);
+  entries_.push_front(Entry{key, adaptor, std::move(buf), pieceLength});
+  index_.insert(std::make_pair(key, std::begin(entries_)));
+  total_ += pieceLength;
+  // The new entry comes first and it is not larger than the limit, so
+  // it is never evicted here.
+  ensureLimit();
+  return &entries_.front();
+}
+
+void RdDiskCache::remove(const std::shared_ptr<DiskAdaptor>& adaptor,
+                         size_t index)
+{
+  auto i = index_.find(std::make_pair(adaptor.get(), index));
+  if (i != std::end(index_)) {
+    erase(i);
+  }
+}
+
+void RdDiskCache::erase(EntryMap::iterator i)
+{
+  total_ -= (*(*i).second).length;
+  entries_.erase((*i).second);
+  index_.erase(i);
+}
+
+void RdDiskCache::ensureLimit()
+{
+  while (static_cast<int64_t>(total_) > limit_) {
+    auto& ent = entries_.back();
+    A2_LOG_DEBUG(fmt("Evict read cache entry index=%lu, size=%lu",
+                     static_cast<unsigned long>(ent.key.second),
+                     static_cast<unsigned long>(ent.length)));
+    ++evictions_;
+    erase(index_.find(ent.key));
+  }
+}
+
+} // namespace aria2
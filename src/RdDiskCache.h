@@ -0,0 +1,122 @@
+/* <!-- copyright */
+/*
+ * aria2 - The high speed download utility
+ *
+ * Copyright (C) 2012 Tatsuhiro Tsujikawa
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * In addition, as a special exception, the copyright holders give
+ * permission to link the code of portions of this program with the
+ * OpenSSL library under certain conditions as described in each
+ * individual source file, and distribute linked combinations
+ * including the two.
+ * You must obey the GNU General Public License in all respects
+ * for all of the code used other than OpenSSL.  If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so.  If you
+ * do not wish to do so, delete this exception statement from your
+ * version.  If you delete this exception statement from all source
+ * files in the program, then also delete it here.
+ */
+/* copyright --> */
+#ifndef D_RD_DISK_CACHE_H
+#define D_RD_DISK_CACHE_H
+
+#include "common.h"
+
+#include <list>
+#include <map>
+#include <memory>
+
+namespace aria2 {
+
+class DiskAdaptor;
+
+// Caches whole pieces read from disk, so that the blocks of a piece
+// requested by peers are served from memory after the first request.
+// Entries are evicted in least recently used order.
+class RdDiskCache {
+public:
+  RdDiskCache(int64_t limit);
+  ~RdDiskCache();
+  // Reads |len| bytes at the offset |offset| of |adaptor| into
+  // |data|.  The range must lie inside the piece |index|, which
+  // starts at |pieceOffset| and is |pieceLength| bytes long.  If the
+  // piece is not cached, it is read from |adaptor| in whole and
+  // cached.  Returns the number of bytes read.
+  ssize_t readData(const std::shared_ptr<DiskAdaptor>& adaptor, size_t index,
+                   int64_t pieceOffset, size_t pieceLength,
+                   unsigned char* data, size_t len, int64_t offset);
+  // Reads the piece |index| of |adaptor|, which starts at
+  // |pieceOffset| and is |pieceLength| bytes long, into the cache in
+  // advance if the 2 preceding pieces are cached, that is, the pieces
+  // are likely requested sequentially.  Does nothing if the piece is
+  // already cached or it is larger than a half of the limit.
+  void readAhead(const std::shared_ptr<DiskAdaptor>& adaptor, size_t index,
+                 int64_t pieceOffset, size_t pieceLength);
+  // Removes the cached piece |index| of |adaptor|, if any.
+  void remove(const std::shared_ptr<DiskAdaptor>& adaptor, size_t index);
+  size_t getSize() const { return total_; }
+  int64_t getLimit() const { return limit_; }
+  uint64_t getHits() const { return hits_; }
+  uint64_t getMisses() const { return misses_; }
+  uint64_t getEvictions() const { return evictions_; }
+  uint64_t getReadAheads() const { return readAheads_; }
+
+private:
+  typedef std::pair<DiskAdaptor*, size_t> Key;
+  struct Entry {
+    Key key;
+    // Used to detect that the DiskAdaptor has gone and its address
+    // may have been reused by another one.
+    std::weak_ptr<DiskAdaptor> adaptor;
+    std::unique_ptr<unsigned char[]> data;
+    size_t length;
+  };
+  typedef std::list<Entry> EntryList;
+  typedef std::map<Key, EntryList::iterator> EntryMap;
+
+  // Returns the entry of the piece |index| of |adaptor|, or
+  // std::end(index_) if it is not cached.  The stale entry left by
+  // the DiskAdaptor which has gone is removed.
+  EntryMap::iterator find(const std::shared_ptr<DiskAdaptor>& adaptor,
+                          size_t index);
+  // Reads the piece in whole from |adaptor| and caches it as the most
+  // recently used entry.  Returns the cached entry, or nullptr if the
+  // piece could not be read in whole.
+  Entry* load(const std::shared_ptr<DiskAdaptor>& adaptor, size_t index,
+              int64_t pieceOffset, size_t pieceLength);
+  void erase(EntryMap::iterator i);
+  // Evicts least recently used entries until the total size of cache
+  // is kept under the limit.
+  void ensureLimit();
+
+  // Maximum number of bytes the storage can cache.
+  int64_t limit_;
+  // Current number of bytes cached.
+  size_t total_;
+  // Most recently used entry comes first.
+  EntryList entries_;
+  EntryMap index_;
+  uint64_t hits_;
+  uint64_t misses_;
+  uint64_t evictions_;
+  uint64_t readAheads_;
+};
+
+} // namespace aria2
+
+#endif // D_RD_DISK_CACHE_H
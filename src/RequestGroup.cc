@@ -597,6 +597,7 @@ void RequestGroup::initPieceStorage()
 #endif // !ENABLE_BITTORRENT
     if (requestGroupMan_) {
       ps->setWrDiskCache(requestGroupMan_->getWrDiskCache());
+      ps->setRdDiskCache(requestGroupMan_->getRdDiskCache());
     }
     if (diskWriterFactory_) {
       ps->setDiskWriterFactory(diskWriterFactory_);
@@ -78,6 +78,7 @@
 #include "Notifier.h"
 #include "PeerStat.h"
 #include "WrDiskCache.h"
+#include "RdDiskCache.h"
 #include "PieceStorage.h"
 #include "DiskAdaptor.h"
 #include "SimpleRandomizer.h"
@@ -1054,6 +1055,15 @@ void RequestGroupMan::initWrDiskCache()
   }
 }
 
+void RequestGroupMan::initRdDiskCache()
+{
+  assert(!rdDiskCache_);
+  int64_t limit = option_->getAsLLInt(PREF_DISK_READ_CACHE);
+  if (limit > 0) {
+    rdDiskCache_ = make_unique<RdDiskCache>(limit);
+  }
+}
+
 void RequestGroupMan::decreaseNumActive()
 {
   assert(numActive_ > 0);
@@ -69,6 +69,7 @@
 #include "MessageDigest.h"
 #include "message_digest_helper.h"
 #include "OpenedFileCounter.h"
+#include "RdDiskCache.h"
 #ifdef ENABLE_BITTORRENT
 #  include "bittorrent_helper.h"
 #  include "BtRegistry.h"
@@ -119,6 +120,7 @@ const char KEY_PORT[] = "port";
 const char KEY_AM_CHOKING[] = "amChoking";
 const char KEY_PEER_CHOKING[] = "peerChoking";
 const char KEY_SEEDER[] = "seeder";
+const char KEY_REQUEST_QUEUE_DEPTH[] = "requestQueueDepth";
 const char KEY_INDEX[] = "index";
 const char KEY_PATH[] = "path";
 const char KEY_SELECTED[] = "selected";
@@ -145,6 +147,10 @@ const char KEY_NUM_WAITING[] = "numWaiting";
 const char KEY_NUM_STOPPED[] = "numStopped";
 const char KEY_NUM_ACTIVE[] = "numActive";
 const char KEY_NUM_STOPPED_TOTAL[] = "numStoppedTotal";
+const char KEY_DISK_READ_CACHE_HITS[] = "diskReadCacheHits";
+const char KEY_DISK_READ_CACHE_MISSES[] = "diskReadCacheMisses";
+const char KEY_DISK_READ_CACHE_HIT_RATIO[] = "diskReadCacheHitRatio";
+const char KEY_DISK_READ_CACHE_EVICTIONS[] = "diskReadCacheEvictions";
 const char KEY_VERIFIED_LENGTH[] = "verifiedLength";
 const char KEY_VERIFY_PENDING[] = "verifyIntegrityPending";
 } // namespace
@@ -778,6 +784,8 @@ void gatherPeer(List* peers, const std::shared_ptr<PeerStorage>& ps)
                    util::itos(peer->calculateDownloadSpeed()));
     peerEntry->put(KEY_UPLOAD_SPEED, util::itos(peer->calculateUploadSpeed()));
     peerEntry->put(KEY_SEEDER, peer->isSeeder() ? VLB_TRUE : VLB_FALSE);
+    peerEntry->put(KEY_REQUEST_QUEUE_DEPTH,
+                   util::uitos(peer->getMaxOutstandingRequest()));
     peers->append(std::move(peerEntry));
   }
 }
@@ -1390,6 +1398,18 @@ GetGlobalStatRpcMethod::process(const RpcRequest& req, DownloadEngine* e)
   res->put(KEY_NUM_STOPPED, util::uitos(rgman->getDownloadResults().size()));
   res->put(KEY_NUM_STOPPED_TOTAL, util::uitos(rgman->getNumStoppedTotal()));
   res->put(KEY_NUM_ACTIVE, util::uitos(rgman->getRequestGroups().size()));
+  auto rdDiskCache = rgman->getRdDiskCache();
+  if (rdDiskCache) {
+    auto hits = rdDiskCache->getHits();
+    auto total = hits + rdDiskCache->getMisses();
+    res->put(KEY_DISK_READ_CACHE_HITS, util::uitos(hits));
+    res->put(KEY_DISK_READ_CACHE_MISSES,
+             util::uitos(rdDiskCache->getMisses()));
+    res->put(KEY_DISK_READ_CACHE_HIT_RATIO,
+             util::uitos(total == 0 ? 0 : hits * 100 / total));
+    res->put(KEY_DISK_READ_CACHE_EVICTIONS,
+             util::uitos(rdDiskCache->getEvictions()));
+  }
   return std::move(res);
 }
 
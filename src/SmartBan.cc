@@ -0,0 +1,124 @@
+/* <!-- copyright */
+/*
+ * aria2 - The high speed download utility
+ *
+ * Copyright (C) 2012 Tatsuhiro Tsujikawa
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * In addition, as a special exception, the copyright holders give
+ * permission to link the code of portions of this program with the
+ * OpenSSL library under certain conditions as described in each
+ * individual source file, and distribute linked combinations
+ * including the two.
+ * You must obey the GNU General Public License in all respects
+ * for all of the code used other than OpenSSL.  If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so.  If you
+ * do not wish to do so, delete this exception statement from your
+ * version.  If you delete this exception statement from all source
+ * files in the program, then also delete it here.
+ */
+/* copyright --> */
+#include "SmartBan.h"
+
+#include <algorithm>
+#include <set>
+
+#include "Piece.h"
+
+namespace aria2 {
+
+SmartBan::SmartBan() = default;
+
+SmartBan::~SmartBan() = default;
+
+void SmartBan::addFailedPiece(const Piece& piece,
+                              const std::vector<std::string>& digests)
+{
+  auto& blocks = records_[piece.getIndex()];
+  for (size_t i = 0; i < digests.size(); ++i) {
+    const auto& ipaddr = piece.getBlockContributor(i);
+    if (ipaddr.empty()) {
+      continue;
+    }
+    // The same peer may send the same data again when the piece fails
+    // repeatedly.
+    if (std::find_if(std::begin(blocks), std::end(blocks),
+                     [&](const Block& b) {
+                       return b.blockIndex == i && b.ipaddr == ipaddr &&
+                              b.digest == digests[i];
+                     }) != std::end(blocks)) {
+      continue;
+    }
+    blocks.push_back(Block{i, piece.getBlockLength(i), ipaddr, digests[i]});
+  }
+  if (blocks.empty()) {
+    records_.erase(piece.getIndex());
+  }
+}
+
+bool SmartBan::hasRecord(size_t index) const
+{
+  return records_.count(index);
+}
+
+std::map<std::string, int64_t>
+SmartBan::findCorruptPeers(size_t index,
+                           const std::vector<std::string>& digests)
+{
+  std::map<std::string, int64_t> res;
+  auto i = records_.find(index);
+  if (i == std::end(records_)) {
+    return res;
+  }
+  for (auto& b : (*i).second) {
+    if (b.blockIndex < digests.size() && b.digest != digests[b.blockIndex]) {
+      res[b.ipaddr] += b.length;
+    }
+  }
+  records_.erase(i);
+  return res;
+}
+
+std::vector<size_t> SmartBan::findFailedPieces(const std::string& ipaddr) const
+{
+  std::vector<size_t> res;
+  for (auto& r : records_) {
+    if (std::find_if(std::begin(r.second), std::end(r.second),
+                     [&ipaddr](const Block& b) {
+                       return b.ipaddr == ipaddr;
+                     }) != std::end(r.second)) {
+      res.push_back(r.first);
+    }
+  }
+  return res;
+}
+
+bool SmartBan::avoidPeer(size_t index, const std::string& ipaddr,
+                         size_t availability) const
+{
+  auto i = records_.find(index);
+  if (i == std::end(records_)) {
+    return false;
+  }
+  std::set<std::string> contributors;
+  for (auto& b : (*i).second) {
+    contributors.insert(b.ipaddr);
+  }
+  return contributors.count(ipaddr) && availability > contributors.size();
+}
+
+} // namespace aria2
@@ -0,0 +1,98 @@
+/* <!-- copyright */
+/*
+ * aria2 - The high speed download utility
+ *
+ * Copyright (C) 2012 Tatsuhiro Tsujikawa
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * In addition, as a special exception, the copyright holders give
+ * permission to link the code of portions of this program with the
+ * OpenSSL library under certain conditions as described in each
+ * individual source file, and distribute linked combinations
+ * including the two.
+ * You must obey the GNU General Public License in all respects
+ * for all of the code used other than OpenSSL.  If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so.  If you
+ * do not wish to do so, delete this exception statement from your
+ * version.  If you delete this exception statement from all source
+ * files in the program, then also delete it here.
+ */
+/* copyright --> */
+#ifndef D_SMART_BAN_H
+#define D_SMART_BAN_H
+
+#include "common.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace aria2 {
+
+class Piece;
+
+// Finds the peer which sent corrupt data when a piece downloaded from
+// several peers fails the hash check.  The digest of each block of
+// the bad piece is remembered together with the peer which sent it.
+// When the piece is downloaded again and passes the hash check, the
+// blocks are compared and the peers which sent different data are
+// found.
+class SmartBan {
+public:
+  SmartBan();
+  ~SmartBan();
+  // Remembers the blocks of |piece| which failed the hash check.
+  // |digests| are the digests of the blocks indexed by block index.
+  // The blocks whose contributor is unknown are ignored.
+  void addFailedPiece(const Piece& piece,
+                      const std::vector<std::string>& digests);
+  // Returns true if there are blocks remembered for the piece
+  // |index|.
+  bool hasRecord(size_t index) const;
+  // Compares the blocks remembered for the piece |index| with
+  // |digests|, which are the digests of its blocks after the piece
+  // passed the hash check.  Returns the IP addresses of the peers
+  // which sent corrupt blocks, mapped to the number of corrupt bytes
+  // they sent.  The records of the piece are removed.
+  std::map<std::string, int64_t>
+  findCorruptPeers(size_t index, const std::vector<std::string>& digests);
+  size_t countRecord() const { return records_.size(); }
+  // Returns the indexes of the remembered pieces the peer |ipaddr|
+  // sent blocks of.
+  std::vector<size_t> findFailedPieces(const std::string& ipaddr) const;
+  // Returns true if the piece |index| should not be downloaded from
+  // the peer |ipaddr| again: the peer sent blocks of it when it
+  // failed, and |availability| peers have the piece, which is more
+  // than the number of peers which sent its blocks.
+  bool avoidPeer(size_t index, const std::string& ipaddr,
+                 size_t availability) const;
+
+private:
+  struct Block {
+    size_t blockIndex;
+    int32_t length;
+    std::string ipaddr;
+    std::string digest;
+  };
+
+  // Blocks of failed pieces, keyed by piece index.
+  std::map<size_t, std::vector<Block>> records_;
+};
+
+} // namespace aria2
+
+#endif // D_SMART_BAN_H
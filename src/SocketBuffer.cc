@@ -46,6 +46,13 @@
 
 namespace aria2 {
 
+namespace {
+// The maximum number of bytes gathered into a single writev() call.
+// This is large enough to send several 16KiB BitTorrent blocks at
+// once when seeding.
+constexpr ssize_t MAX_SEND_VECTOR_LENGTH = 256_k;
+} // namespace
+
 SocketBuffer::ByteArrayBufEntry::ByteArrayBufEntry(
     std::vector<unsigned char> bytes,
     std::unique_ptr<ProgressUpdate> progressUpdate)
@@ -134,7 +141,7 @@ ssize_t SocketBuffer::send()
   while (!bufq_.empty()) {
     size_t num;
     size_t bufqlen = bufq_.size();
-    ssize_t amount = 24_k;
+    ssize_t amount = MAX_SEND_VECTOR_LENGTH;
     ssize_t firstlen = bufq_.front()->getLength() - offset_;
     amount -= firstlen;
     iov[0].A2IOVEC_BASE = reinterpret_cast<char*>(
@@ -61,6 +61,7 @@
 #ifdef ENABLE_SSL
 #  include "TLSContext.h"
 #  include "TLSSession.h"
+#  include "TLSSessionCache.h"
 #endif // ENABLE_SSL
 #ifdef HAVE_LIBSSH2
 #  include "SSHSession.h"
@@ -139,11 +140,14 @@ int SocketCore::socketRecvBufferSize_ = 0;
 #ifdef ENABLE_SSL
 std::shared_ptr<TLSContext> SocketCore::clTlsContext_;
 std::shared_ptr<TLSContext> SocketCore::svTlsContext_;
+std::shared_ptr<TLSSessionCache> SocketCore::tlsSessionCache_;
 
 void SocketCore::setClientTLSContext(
-    const std::shared_ptr<TLSContext>& tlsContext)
+    const std::shared_ptr<TLSContext>& tlsContext,
+    const std::shared_ptr<TLSSessionCache>& sessionCache)
 {
   clTlsContext_ = tlsContext;
+  tlsSessionCache_ = sessionCache;
 }
 
 void SocketCore::setServerTLSContext(
@@ -635,9 +639,15 @@ void SocketCore::closeConnection()
 {
 #ifdef ENABLE_SSL
   if (tlsSession_) {
+    // With TLS 1.3, the session ticket arrives after handshake, so we
+    // store the session again here.
+    if (secure_ == A2_TLS_CONNECTED) {
+      storeTLSSession();
+    }
     tlsSession_->closeConnection();
     tlsSession_.reset();
   }
+  tlsSessionKey_.clear();
 #endif // ENABLE_SSL
 
 #ifdef HAVE_LIBSSH2
@@ -904,15 +914,24 @@ void SocketCore::readData(void* data, size_t& len)
 
 bool SocketCore::tlsAccept()
 {
-  return tlsHandshake(svTlsContext_.get(), A2STR::NIL);
+  return tlsHandshake(svTlsContext_.get(), A2STR::NIL, 0);
 }
 
-bool SocketCore::tlsConnect(const std::string& hostname)
+bool SocketCore::tlsConnect(const std::string& hostname, uint16_t port)
 {
-  return tlsHandshake(clTlsContext_.get(), hostname);
+  return tlsHandshake(clTlsContext_.get(), hostname, port);
+}
+
+void SocketCore::storeTLSSession()
+{
+  if (tlsSessionKey_.empty() || !tlsSessionCache_) {
+    return;
+  }
+  tlsSessionCache_->put(tlsSessionKey_, tlsSession_->getSessionData());
 }
 
-bool SocketCore::tlsHandshake(TLSContext* tlsctx, const std::string& hostname)
+bool SocketCore::tlsHandshake(TLSContext* tlsctx, const std::string& hostname,
+                              uint16_t port)
 {
   wantRead_ = false;
   wantWrite_ = false;
@@ -942,6 +961,21 @@ bool SocketCore::tlsHandshake(TLSContext* tlsctx, const std::string& hostname)
                               tlsSession_->getLastErrorString().c_str()));
       }
     }
+    if (tlsctx->getSide() == TLS_CLIENT && tlsSessionCache_ &&
+        !hostname.empty()) {
+      tlsSessionKey_ = fmt("%s:%u", hostname.c_str(), port);
+      auto data = tlsSessionCache_->get(tlsSessionKey_);
+      if (!data.empty() && tlsSession_->setSessionData(data) != TLS_ERR_OK) {
+        A2_LOG_DEBUG(fmt("Discarded broken TLS session for %s",
+                         tlsSessionKey_.c_str()));
+        tlsSessionCache_->remove(tlsSessionKey_);
+      }
+      A2_LOG_DEBUG(fmt("TLS session cache: %" PRIu64 " hits, %" PRIu64
+                       " misses, %lu entries",
+                       tlsSessionCache_->getHits(),
+                       tlsSessionCache_->getMisses(),
+                       static_cast<unsigned long>(tlsSessionCache_->size())));
+    }
     // Done with the setup, now let handshaking begin immediately.
     secure_ = A2_TLS_HANDSHAKING;
     A2_LOG_DEBUG("TLS Handshaking");
@@ -994,8 +1028,15 @@ bool SocketCore::tlsHandshake(TLSContext* tlsctx, const std::string& hostname)
       A2_LOG_DEBUG(fmt("Securely connected to %s with %s", peerInfo.c_str(),
                        tlsVersion.c_str()));
 
+      if (!tlsSessionKey_.empty()) {
+        if (tlsSession_->isSessionResumed()) {
+          A2_LOG_DEBUG(fmt("Resumed TLS session with %s", peerInfo.c_str()));
+        }
+      }
+
       // 2. We're connected now!
       secure_ = A2_TLS_CONNECTED;
+      storeTLSSession();
       return true;
     }
 
@@ -1015,6 +1056,10 @@ bool SocketCore::tlsHandshake(TLSContext* tlsctx, const std::string& hostname)
     }
 
     if (rv == TLS_ERR_ERROR) {
+      // The cached session may be the cause of the failure.
+      if (!tlsSessionKey_.empty() && tlsSessionCache_) {
+        tlsSessionCache_->remove(tlsSessionKey_);
+      }
       // Damn those error.
       throw DL_ABORT_EX(fmt("SSL/TLS handshake failure: %s",
                             handshakeError.empty()
@@ -53,6 +53,7 @@ namespace aria2 {
 #ifdef ENABLE_SSL
 class TLSContext;
 class TLSSession;
+class TLSSessionCache;
 #endif // ENABLE_SSL
 
 #ifdef HAVE_LIBSSH2
@@ -90,16 +91,28 @@ private:
   static std::shared_ptr<TLSContext> clTlsContext_;
   // TLS context for server side
   static std::shared_ptr<TLSContext> svTlsContext_;
+  // Cache of client side sessions. If this is null, sessions are not
+  // resumed.
+  static std::shared_ptr<TLSSessionCache> tlsSessionCache_;
 
   std::shared_ptr<TLSSession> tlsSession_;
 
+  // The key of the client side session in tlsSessionCache_. Empty if
+  // the session is not cached.
+  std::string tlsSessionKey_;
+
+  // Stores the current client side session in the session cache so
+  // that the next connection to the same server can resume it.
+  void storeTLSSession();
+
   /**
    * Makes this socket secure. The connection must be established
    * before calling this method.
    *
    * If you are going to verify peer's certificate, hostname must be supplied.
    */
-  bool tlsHandshake(TLSContext* tlsctx, const std::string& hostname);
+  bool tlsHandshake(TLSContext* tlsctx, const std::string& hostname,
+                    uint16_t port);
 #endif // ENABLE_SSL
 
 #ifdef HAVE_LIBSSH2
@@ -294,8 +307,9 @@ public:
   // returns true. If handshake has not been done yet, returns false.
   //
   // If you are going to verify peer's certificate, hostname must be
-  // supplied.
-  bool tlsConnect(const std::string& hostname);
+  // supplied. The session is cached under |hostname| and |port|,
+  // which must be those of the origin server, not of the proxy.
+  bool tlsConnect(const std::string& hostname, uint16_t port);
 #endif // ENABLE_SSL
 
 #ifdef HAVE_LIBSSH2
@@ -343,8 +357,11 @@ public:
   size_t getRecvBufferedLength() const;
 
 #ifdef ENABLE_SSL
-  static void
-  setClientTLSContext(const std::shared_ptr<TLSContext>& tlsContext);
+  // |sessionCache| is used to resume client side sessions. If it is
+  // null, every connection does a full handshake.
+  static void setClientTLSContext(
+      const std::shared_ptr<TLSContext>& tlsContext,
+      const std::shared_ptr<TLSSessionCache>& sessionCache = nullptr);
   static void
   setServerTLSContext(const std::shared_ptr<TLSContext>& tlsContext);
 #endif // ENABLE_SSL
@@ -36,28 +36,115 @@
 
 #include <cstring>
 #include <cassert>
+#include <map>
+#include <vector>
 
 #include "SocketCore.h"
 #include "LogFactory.h"
 
 namespace aria2 {
 
+namespace {
+constexpr size_t MIN_CAPACITY = 16_k;
+constexpr size_t MAX_CAPACITY = 1_m;
+// The maximum number of bytes kept in the buffer pool.
+constexpr size_t MAX_POOL_SIZE = 4_m;
+} // namespace
+
+namespace {
+// Buffers released by SocketRecvBuffer, keyed by their capacity.
+// aria2 is single threaded, so no locking is needed.
+class BufferPool {
+public:
+  BufferPool() : size_(0) {}
+
+  std::unique_ptr<unsigned char[]> acquire(size_t capacity)
+  {
+    auto i = pool_.find(capacity);
+    if (i == std::end(pool_) || (*i).second.empty()) {
+      return std::unique_ptr<unsigned char[]>(new unsigned char[capacity]);
+    }
+    auto buf = std::move((*i).second.back());
+    (*i).second.pop_back();
+    size_ -= capacity;
+    return buf;
+  }
+
+  void release(std::unique_ptr<unsigned char[]> buf, size_t capacity)
+  {
+    if (!buf || size_ + capacity > MAX_POOL_SIZE) {
+      return;
+    }
+    pool_[capacity].push_back(std::move(buf));
+    size_ += capacity;
+  }
+
+private:
+  std::map<size_t, std::vector<std::unique_ptr<unsigned char[]>>> pool_;
+  size_t size_;
+};
+
+BufferPool& getBufferPool()
+{
+  static BufferPool pool;
+  return pool;
+}
+} // namespace
+
 SocketRecvBuffer::SocketRecvBuffer(std::shared_ptr<SocketCore> socket)
-    : socket_(std::move(socket)), pos_(buf_.data()), last_(pos_)
+    : capacity_(0),
+      socket_(std::move(socket)),
+      pos_(nullptr),
+      last_(nullptr),
+      lastRecvFull_(false),
+      lastRecvLength_(0)
 {
 }
 
-SocketRecvBuffer::~SocketRecvBuffer() = default;
+SocketRecvBuffer::~SocketRecvBuffer()
+{
+  getBufferPool().release(std::move(buf_), capacity_);
+}
+
+void SocketRecvBuffer::reallocate(size_t capacity)
+{
+  assert(bufferEmpty());
+  auto& pool = getBufferPool();
+  pool.release(std::move(buf_), capacity_);
+  buf_ = pool.acquire(capacity);
+  capacity_ = capacity;
+  truncateBuffer();
+}
 
 ssize_t SocketRecvBuffer::recv()
 {
-  size_t n = std::end(buf_) - last_;
+  if (!buf_) {
+    reallocate(MIN_CAPACITY);
+  }
+  else if (bufferEmpty()) {
+    if (lastRecvFull_ && capacity_ < MAX_CAPACITY) {
+      reallocate(capacity_ * 2);
+    }
+    else if (lastRecvLength_ > 0 && lastRecvLength_ < capacity_ / 4 &&
+             capacity_ > MIN_CAPACITY) {
+      reallocate(capacity_ / 2);
+    }
+  }
+  bool empty = bufferEmpty();
+  size_t n = buf_.get() + capacity_ - last_;
   if (n == 0) {
     A2_LOG_DEBUG("Buffer full");
     return 0;
   }
+  size_t len = n;
   socket_->readData(last_, n);
   last_ += n;
+  if (n > 0) {
+    lastRecvFull_ = n == len;
+    if (empty) {
+      lastRecvLength_ = n;
+    }
+  }
   return n;
 }
 
@@ -70,6 +157,6 @@ void SocketRecvBuffer::drain(size_t n)
   }
 }
 
-void SocketRecvBuffer::truncateBuffer() { pos_ = last_ = buf_.data(); }
+void SocketRecvBuffer::truncateBuffer() { pos_ = last_ = buf_.get(); }
 
 } // namespace aria2
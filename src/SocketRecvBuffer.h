@@ -38,7 +38,6 @@
 #include "common.h"
 
 #include <memory>
-#include <array>
 
 #include "a2functional.h"
 
@@ -46,6 +45,12 @@ namespace aria2 {
 
 class SocketCore;
 
+// Buffer for data received from socket.  The buffer is allocated on
+// the first recv() from the pool shared by all SocketRecvBuffer
+// objects, and returned to the pool on destruction.  Its capacity
+// grows while the socket fills the whole buffer, and shrinks when
+// only a small part of it is used.  The capacity only changes when
+// the buffer is empty, so that the buffered data never moves.
 class SocketRecvBuffer {
 public:
   SocketRecvBuffer(std::shared_ptr<SocketCore> socket);
@@ -68,11 +73,24 @@ public:
 
   bool bufferEmpty() const { return pos_ == last_; }
 
+  // Returns the capacity of the buffer.  Returns 0 if the buffer has
+  // not been allocated yet.
+  size_t getCapacity() const { return capacity_; }
+
 private:
-  std::array<unsigned char, 16_k> buf_;
+  // Replaces the buffer with the one of |capacity| bytes.  The buffer
+  // must be empty.
+  void reallocate(size_t capacity);
+
+  std::unique_ptr<unsigned char[]> buf_;
+  size_t capacity_;
   std::shared_ptr<SocketCore> socket_;
   unsigned char* pos_;
   unsigned char* last_;
+  // true if the last recv() filled all space left in the buffer.
+  bool lastRecvFull_;
+  // The number of bytes read by the last recv() into empty buffer.
+  size_t lastRecvLength_;
 };
 
 } // namespace aria2
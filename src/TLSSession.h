@@ -39,6 +39,8 @@
 #include "a2netcompat.h"
 #include "TLSContext.h"
 
+#include <string>
+
 namespace aria2 {
 
 enum TLSDirection { TLS_WANT_READ = 1, TLS_WANT_WRITE };
@@ -68,6 +70,22 @@ public:
   // succeeds, or TLS_ERR_ERROR.
   virtual int setSNIHostname(const std::string& hostname) = 0;
 
+  // Sets the serialized session |data| obtained by getSessionData() to
+  // resume the session. This must be called before handshake and is
+  // only meaningful for client side session. This function returns
+  // TLS_ERR_OK if it succeeds, or TLS_ERR_ERROR. The backends which do
+  // not support resumption ignore |data| and return TLS_ERR_OK.
+  virtual int setSessionData(const std::string& data) { return TLS_ERR_OK; }
+
+  // Returns the serialized data of the current session which can be
+  // resumed later, or empty string if it is not available. With TLS
+  // 1.3, the data is available only after the server sent a session
+  // ticket, which is usually after handshake.
+  virtual std::string getSessionData() { return ""; }
+
+  // Returns true if the session was resumed in the last handshake.
+  virtual bool isSessionResumed() { return false; }
+
   // Closes the SSL/TLS session. Don't close underlying transport
   // socket. This function returns TLS_ERR_OK if it succeeds, or
   // TLS_ERR_ERROR.
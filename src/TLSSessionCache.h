@@ -0,0 +1,84 @@
+/* <!-- copyright */
+/*
+ * aria2 - The high speed download utility
+ *
+ * Copyright (C) 2012 Tatsuhiro Tsujikawa
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * In addition, as a special exception, the copyright holders give
+ * permission to link the code of portions of this program with the
+ * OpenSSL library under certain conditions as described in each
+ * individual source file, and distribute linked combinations
+ * including the two.
+ * You must obey the GNU General Public License in all respects
+ * for all of the code used other than OpenSSL.  If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so.  If you
+ * do not wish to do so, delete this exception statement from your
+ * version.  If you delete this exception statement from all source
+ * files in the program, then also delete it here.
+ */
+/* copyright --> */
+#ifndef D_TLS_SESSION_CACHE_H
+#define D_TLS_SESSION_CACHE_H
+
+#include "common.h"
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace aria2 {
+
+// Client side cache of TLS sessions, used to resume a session instead
+// of doing a full handshake when connecting to the same server again.
+// The key is usually "hostname:port", and the value is serialized
+// session data obtained from TLSSession::getSessionData(). When the
+// cache is full, the least recently used entry is evicted.
+class TLSSessionCache {
+public:
+  TLSSessionCache(size_t capacity = 256);
+  ~TLSSessionCache();
+
+  // Returns the session data for |key|, or empty string if it is not
+  // found. The hit and miss counters are updated.
+  std::string get(const std::string& key);
+  // Stores |data| for |key|. If |data| is empty, this function does
+  // nothing.
+  void put(const std::string& key, const std::string& data);
+  // Removes the session data for |key|.
+  void remove(const std::string& key);
+
+  size_t size() const { return entries_.size(); }
+  size_t getCapacity() const { return capacity_; }
+  uint64_t getHits() const { return hits_; }
+  uint64_t getMisses() const { return misses_; }
+
+private:
+  typedef std::list<std::pair<std::string, std::string>> EntryList;
+
+  size_t capacity_;
+  // The most recently used entry comes first.
+  EntryList entries_;
+  std::unordered_map<std::string, EntryList::iterator> index_;
+  uint64_t hits_;
+  uint64_t misses_;
+};
+
+} // namespace aria2
+
+#endif // D_TLS_SESSION_CACHE_H
@@ -122,6 +122,12 @@ std::shared_ptr<Piece> UnknownLengthPieceStorage::getMissingPiece(
 {
   abort();
 }
+
+bool UnknownLengthPieceStorage::getSuperSeedingPiece(
+    size_t& index, const std::shared_ptr<Peer>& peer)
+{
+  abort();
+}
 #endif // ENABLE_BITTORRENT
 
 bool UnknownLengthPieceStorage::hasMissingUnusedPiece() { abort(); }
@@ -109,6 +109,12 @@ public:
   getMissingPiece(const std::shared_ptr<Peer>& peer,
                   const std::vector<size_t>& excludedIndexes,
                   cuid_t cuid) CXX11_OVERRIDE;
+
+  virtual bool
+  getSuperSeedingPiece(size_t& index,
+                       const std::shared_ptr<Peer>& peer) CXX11_OVERRIDE;
+
+  virtual SmartBan* getSmartBan() CXX11_OVERRIDE { return nullptr; }
 #endif // ENABLE_BITTORRENT
 
   virtual bool hasMissingUnusedPiece() CXX11_OVERRIDE;
@@ -216,6 +222,8 @@ public:
 
   virtual WrDiskCache* getWrDiskCache() CXX11_OVERRIDE { return nullptr; }
 
+  virtual RdDiskCache* getRdDiskCache() CXX11_OVERRIDE { return nullptr; }
+
   virtual void flushWrDiskCacheEntry(bool releaseEntries) CXX11_OVERRIDE {}
 
   virtual int32_t getPieceLength(size_t index) CXX11_OVERRIDE;
@@ -263,6 +271,11 @@ public:
 
   virtual void addPieceStats(size_t index) CXX11_OVERRIDE {}
 
+  virtual size_t getPieceAvailability(size_t index) CXX11_OVERRIDE
+  {
+    return 0;
+  }
+
   virtual void addPieceStats(const unsigned char* bitfield,
                              size_t bitfieldLength) CXX11_OVERRIDE
   {
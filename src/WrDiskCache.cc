@@ -42,7 +42,10 @@
 
 namespace aria2 {
 
-WrDiskCache::WrDiskCache(size_t limit) : limit_(limit), total_(0), clock_(0) {}
+WrDiskCache::WrDiskCache(size_t limit)
+    : limit_(limit), total_(0), head_(nullptr), tail_(nullptr), clock_(0)
+{
+}
 
 WrDiskCache::~WrDiskCache()
 {
@@ -52,53 +55,82 @@ WrDiskCache::~WrDiskCache()
   }
 }
 
-bool WrDiskCache::add(WrDiskCacheEntry* ent)
+void WrDiskCache::link(WrDiskCacheEntry* ent)
 {
-  ent->setSizeKey(ent->getSize());
   ent->setLastUpdate(++clock_);
-  std::pair<EntrySet::iterator, bool> rv = set_.insert(ent);
-  if (rv.second) {
-    total_ += ent->getSize();
-    ensureLimit();
-    return true;
+  ent->prev_ = tail_;
+  ent->next_ = nullptr;
+  if (tail_) {
+    tail_->next_ = ent;
+  }
+  else {
+    head_ = ent;
+  }
+  tail_ = ent;
+  ent->linked_ = true;
+}
+
+void WrDiskCache::unlink(WrDiskCacheEntry* ent)
+{
+  if (ent->prev_) {
+    ent->prev_->next_ = ent->next_;
   }
   else {
-    A2_LOG_WARN(fmt("Found duplicate cache entry a.{size=%lu,clock=%" PRId64
-                    "} b{size=%lu,clock=%" PRId64 "}",
-                    static_cast<unsigned long>((*rv.first)->getSize()),
-                    (*rv.first)->getLastUpdate(),
+    head_ = ent->next_;
+  }
+  if (ent->next_) {
+    ent->next_->prev_ = ent->prev_;
+  }
+  else {
+    tail_ = ent->prev_;
+  }
+  ent->prev_ = ent->next_ = nullptr;
+  ent->linked_ = false;
+}
+
+bool WrDiskCache::add(WrDiskCacheEntry* ent)
+{
+  if (ent->linked_) {
+    A2_LOG_WARN(fmt("Found duplicate cache entry size=%lu,clock=%" PRId64,
                     static_cast<unsigned long>(ent->getSize()),
                     ent->getLastUpdate()));
     return false;
   }
+  link(ent);
+  total_ += ent->getSize();
+  ensureLimit();
+  return true;
 }
 
 bool WrDiskCache::remove(WrDiskCacheEntry* ent)
 {
-  if (set_.erase(ent)) {
-    A2_LOG_DEBUG(fmt("Removed cache entry size=%lu, clock=%" PRId64,
-                     static_cast<unsigned long>(ent->getSize()),
-                     ent->getLastUpdate()));
-    total_ -= ent->getSize();
-    return true;
-  }
-  else {
+  if (!ent->linked_) {
     return false;
   }
+  A2_LOG_DEBUG(fmt("Removed cache entry size=%lu, clock=%" PRId64,
+                   static_cast<unsigned long>(ent->getSize()),
+                   ent->getLastUpdate()));
+  unlink(ent);
+  total_ -= ent->getSize();
+  return true;
 }
 
 bool WrDiskCache::update(WrDiskCacheEntry* ent, ssize_t delta)
 {
-  if (!set_.erase(ent)) {
+  if (!ent->linked_) {
     return false;
   }
   A2_LOG_DEBUG(fmt("Update cache entry size=%lu, delta=%ld, clock=%" PRId64,
                    static_cast<unsigned long>(ent->getSize()),
                    static_cast<long>(delta), ent->getLastUpdate()));
 
-  ent->setSizeKey(ent->getSize());
-  ent->setLastUpdate(++clock_);
-  set_.insert(ent);
+  if (ent != tail_) {
+    unlink(ent);
+    link(ent);
+  }
+  else {
+    ent->setLastUpdate(++clock_);
+  }
 
   if (delta < 0) {
     assert(total_ >= static_cast<size_t>(-delta));
@@ -111,18 +143,15 @@ bool WrDiskCache::update(WrDiskCacheEntry* ent, ssize_t delta)
 void WrDiskCache::ensureLimit()
 {
   while (total_ > limit_) {
-    auto i = set_.begin();
-    WrDiskCacheEntry* ent = *i;
+    WrDiskCacheEntry* ent = head_;
+    assert(ent);
     A2_LOG_DEBUG(fmt("Force flush cache entry size=%lu, clock=%" PRId64,
-                     static_cast<unsigned long>(ent->getSizeKey()),
+                     static_cast<unsigned long>(ent->getSize()),
                      ent->getLastUpdate()));
     total_ -= ent->getSize();
     ent->writeToDisk();
-    set_.erase(i);
-
-    ent->setSizeKey(ent->getSize());
-    ent->setLastUpdate(++clock_);
-    set_.insert(ent);
+    unlink(ent);
+    link(ent);
   }
 }
 
@@ -37,10 +37,6 @@
 
 #include "common.h"
 
-#include <set>
-
-#include "a2functional.h"
-
 namespace aria2 {
 
 class WrDiskCacheEntry;
@@ -59,18 +55,26 @@ public:
   // bytes is increased in this update. If the size is reduced, use
   // negative value.
   bool update(WrDiskCacheEntry* ent, ssize_t delta);
-  // Evicts entries from storage so that total size of cache is kept
-  // under the limit.
+  // Evicts least recently updated entries from storage so that total
+  // size of cache is kept under the limit.
   void ensureLimit();
   size_t getSize() const { return total_; }
 
 private:
-  typedef std::set<WrDiskCacheEntry*, DerefLess<WrDiskCacheEntry*>> EntrySet;
+  // Appends |ent| to the tail of the list.
+  void link(WrDiskCacheEntry* ent);
+  // Removes |ent| from the list.
+  void unlink(WrDiskCacheEntry* ent);
+
   // Maximum number of bytes the storage can cache.
   size_t limit_;
   // Current number of bytes cached.
   size_t total_;
-  EntrySet set_;
+  // Doubly linked list of entries threaded through WrDiskCacheEntry.
+  // head_ is the least recently updated entry, tail_ is the most
+  // recently updated one.
+  WrDiskCacheEntry* head_;
+  WrDiskCacheEntry* tail_;
   int64_t clock_;
 };
 
@@ -46,8 +46,10 @@ namespace aria2 {
 
 WrDiskCacheEntry::WrDiskCacheEntry(
     const std::shared_ptr<DiskAdaptor>& diskAdaptor)
-    : sizeKey_(0),
-      lastUpdate_(0),
+    : lastUpdate_(0),
+      prev_(nullptr),
+      next_(nullptr),
+      linked_(false),
       size_(0),
       error_(CACHE_ERR_SUCCESS),
       errorCode_(error_code::UNDEFINED),
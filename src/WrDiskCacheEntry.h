@@ -81,15 +81,8 @@ public:
   size_t append(int64_t goff, const unsigned char* data, size_t len);
 
   size_t getSize() const { return size_; }
-  void setSizeKey(size_t sizeKey) { sizeKey_ = sizeKey; }
-  size_t getSizeKey() const { return sizeKey_; }
   void setLastUpdate(int64_t clock) { lastUpdate_ = clock; }
   int64_t getLastUpdate() const { return lastUpdate_; }
-  bool operator<(const WrDiskCacheEntry& rhs) const
-  {
-    return sizeKey_ > rhs.sizeKey_ ||
-           (sizeKey_ == rhs.sizeKey_ && lastUpdate_ < rhs.lastUpdate_);
-  }
 
   enum { CACHE_ERR_SUCCESS, CACHE_ERR_ERROR };
 
@@ -99,11 +92,19 @@ public:
   const DataCellSet& getDataSet() const { return set_; }
 
 private:
+  friend class WrDiskCache;
+
   void deleteDataCells();
 
-  size_t sizeKey_;
   int64_t lastUpdate_;
 
+  // Links of the list in WrDiskCache, which is ordered by the time of
+  // last update.  Managed by WrDiskCache.
+  WrDiskCacheEntry* prev_;
+  WrDiskCacheEntry* next_;
+  // true if this entry is in the list of WrDiskCache.
+  bool linked_;
+
   size_t size_;
 
   DataCellSet set_;
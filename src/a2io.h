@@ -144,6 +144,10 @@
 #  define a2_off_t off_t
 #elif defined(__ANDROID__) || defined(ANDROID)
 #  define a2lseek(fd, offset, origin) lseek64(fd, offset, origin)
+#  define a2pread(fd, buf, count, offset) pread64(fd, buf, count, offset)
+#  define a2pwrite(fd, buf, count, offset) pwrite64(fd, buf, count, offset)
+#  define a2pwritev(fd, iov, iovcnt, offset)                                    \
+    pwritev64(fd, iov, iovcnt, offset)
 // # define a2fseek(fp, offset, origin): No fseek64 and not used in aria2
 #  define a2fstat(fd, buf) fstat64(fd, buf)
 // # define a2ftell(fd): No ftell64 and not used in aria2
@@ -171,6 +175,9 @@ extern int ftruncate64(int fd, off64_t length);
 #  define a2_off_t off64_t
 #else // !__MINGW32__ && !(defined(__ANDROID__) || defined(ANDROID))
 #  define a2lseek(fd, offset, origin) lseek(fd, offset, origin)
+#  define a2pread(fd, buf, count, offset) pread(fd, buf, count, offset)
+#  define a2pwrite(fd, buf, count, offset) pwrite(fd, buf, count, offset)
+#  define a2pwritev(fd, iov, iovcnt, offset) pwritev(fd, iov, iovcnt, offset)
 #  define a2fseek(fp, offset, origin) fseek(fp, offset, origin)
 #  define a2fstat(fp, buf) fstat(fp, buf)
 #  define a2ftell(fp) ftell(fp)
@@ -90,8 +90,38 @@ const int cntbits[] = {
 
 inline size_t countBit32(uint32_t n)
 {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcount(n);
+#else  // !(__GNUC__ || __clang__)
   return cntbits[n & 0xffu] + cntbits[(n >> 8) & 0xffu] +
          cntbits[(n >> 16) & 0xffu] + cntbits[(n >> 24) & 0xffu];
+#endif // !(__GNUC__ || __clang__)
+}
+
+inline size_t countBit64(uint64_t n)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(n);
+#else  // !(__GNUC__ || __clang__)
+  return countBit32(static_cast<uint32_t>(n)) +
+         countBit32(static_cast<uint32_t>(n >> 32));
+#endif // !(__GNUC__ || __clang__)
+}
+
+// Returns the index of the most significant set bit in |b|, counting
+// from the most significant bit.  |b| must not be 0.
+inline size_t firstSetBitInByte(unsigned char b)
+{
+  assert(b);
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_clz(static_cast<unsigned int>(b)) -
+         (sizeof(unsigned int) - 1) * 8;
+#else  // !(__GNUC__ || __clang__)
+  size_t i = 0;
+  for (; !(b & 0x80u); b <<= 1, ++i)
+    ;
+  return i;
+#endif // !(__GNUC__ || __clang__)
 }
 
 // Counts set bit in bitfield.
@@ -100,22 +130,17 @@ inline size_t countSetBit(const unsigned char* bitfield, size_t nbits)
   if (nbits == 0) {
     return 0;
   }
-  size_t count = 0;
-  size_t size = sizeof(uint32_t);
-  size_t len = (nbits + 7) / 8;
-  if (nbits % 32 != 0) {
-    --len;
-    count +=
-        countBit32(static_cast<uint32_t>(bitfield[len] & lastByteMask(nbits)));
-  }
-  size_t to = len / size;
-  for (size_t i = 0; i < to; ++i) {
-    uint32_t v;
-    memcpy(&v, &bitfield[i * size], sizeof(v));
-    count += countBit32(v);
+  size_t len = (nbits + 7) / 8 - 1;
+  size_t count = countBit32(bitfield[len] & lastByteMask(nbits));
+  size_t i = 0;
+  // Process 8 bytes at a time.
+  for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+    uint64_t v;
+    memcpy(&v, &bitfield[i], sizeof(v));
+    count += countBit64(v);
   }
-  for (size_t i = len - len % size; i < len; ++i) {
-    count += countBit32(static_cast<uint32_t>(bitfield[i]));
+  for (; i < len; ++i) {
+    count += countBit32(bitfield[i]);
   }
   return count;
 }
@@ -147,9 +172,14 @@ void flipBit(unsigned char* data, size_t length, size_t bitIndex);
 template <typename Array>
 bool getFirstSetBitIndex(size_t& index, const Array& bitfield, size_t nbits)
 {
-  for (size_t i = 0; i < nbits; ++i) {
-    if (bitfield::test(bitfield, nbits, i)) {
-      index = i;
+  // Skip a byte at a time until we find the non-zero one.
+  for (size_t i = 0, len = (nbits + 7) / 8; i < len; ++i) {
+    unsigned char b = bitfield[i];
+    if (i == len - 1) {
+      b &= lastByteMask(nbits);
+    }
+    if (b) {
+      index = i * 8 + firstSetBitInByte(b);
       return true;
     }
   }
@@ -166,12 +196,18 @@ size_t getFirstNSetBitIndex(OutputIterator out, size_t n, const Array& bitfield,
     return 0;
   }
   const size_t origN = n;
-  for (size_t i = 0; i < nbits; ++i) {
-    if (bitfield::test(bitfield, nbits, i)) {
-      *out++ = i;
+  for (size_t i = 0, len = (nbits + 7) / 8; i < len; ++i) {
+    unsigned char b = bitfield[i];
+    if (i == len - 1) {
+      b &= lastByteMask(nbits);
+    }
+    while (b) {
+      size_t j = firstSetBitInByte(b);
+      *out++ = i * 8 + j;
       if (--n == 0) {
-        break;
+        return origN;
       }
+      b &= ~(0x80u >> j);
     }
   }
   return origN - n;
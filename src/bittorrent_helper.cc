@@ -77,6 +77,7 @@ const char C_PATH_UTF8[] = "path.utf-8";
 const char C_INFO[] = "info";
 const char C_PIECES[] = "pieces";
 const char C_PIECE_LENGTH[] = "piece length";
+const char C_META_VERSION[] = "meta version";
 const char C_PRIVATE[] = "private";
 const char C_URL_LIST[] = "url-list";
 const char C_ANNOUNCE[] = "announce";
@@ -441,6 +442,13 @@ void processRootDictionary(const std::shared_ptr<DownloadContext>& ctx,
 
   // calculate the number of pieces
   const String* piecesData = downcast<String>(infoDict->get(C_PIECES));
+  const Integer* metaVersion = downcast<Integer>(infoDict->get(C_META_VERSION));
+  if (metaVersion && metaVersion->i() >= 2 && !piecesData) {
+    // BEP 52 v2-only torrent.  Hybrid torrents also carry v1 piece
+    // hashes and file list, and they are downloaded as v1 torrents.
+    throw DL_ABORT_EX2("BitTorrent v2-only torrent is not supported.",
+                       error_code::BITTORRENT_PARSE_ERROR);
+  }
   if (!piecesData) {
     throw DL_ABORT_EX2(fmt(MSG_MISSING_BT_INFO, C_PIECES),
                        error_code::BITTORRENT_PARSE_ERROR);
@@ -10,6 +10,14 @@
 #include <stdexcept>
 #include <unordered_map>
 
+// x86 SHA extensions, dispatched at runtime.
+#if (defined(__x86_64__) || defined(__i386__)) &&                             \
+    (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#  define __hash_have_sha_ni 1
+#  include <cpuid.h>
+#  include <immintrin.h>
+#endif // (__x86_64__ || __i386__) && (__clang__ || __GNUC__ >= 5)
+
 // Compiler hints
 #if defined(__GNUG__)
 #  define likely(x) __builtin_expect(!!(x), 1)
@@ -758,6 +766,399 @@ const SHA224::word_t SHA224::initvec[] = {0xc1059ed8, 0x367cd507, 0x3070dd17,
                                           0xf70e5939, 0xffc00b31, 0x68581511,
                                           0x64f98fa7, 0xbefa4fa4};
 
+#ifdef __hash_have_sha_ni
+// SHA-1 and SHA-2 transforms using the x86 SHA extensions.  These are
+// only instantiated by |create| if the CPU announces support for them,
+// see |has_sha_ni|.
+
+static bool has_sha_ni()
+{
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+  // SSSE3 and SSE4.1 are used to shuffle the message and the state.
+  if (!(ecx & (1 << 9)) || !(ecx & (1 << 19))) {
+    return false;
+  }
+  if (__get_cpuid_max(0, nullptr) < 7) {
+    return false;
+  }
+  __cpuid_count(7, 0, eax, ebx, ecx, edx);
+  // CPUID.(EAX=07H, ECX=0):EBX.SHA[bit 29]
+  return ebx & (1 << 29);
+}
+
+static bool use_sha_ni()
+{
+  static const bool rv = has_sha_ni();
+  return rv;
+}
+
+__attribute__((target("sha,sse4.1"))) static void
+sha1_ni_transform(uint32_t* state, const void* buffer)
+{
+  const auto data = reinterpret_cast<const __m128i*>(buffer);
+  const auto mask =
+      _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+  __m128i abcd, e0, e1, msg0, msg1, msg2, msg3;
+
+  abcd = _mm_shuffle_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1b);
+  e0 = _mm_set_epi32(state[4], 0, 0, 0);
+
+  const auto abcd_save = abcd;
+  const auto e0_save = e0;
+
+  // Rounds 0-3
+  msg0 = _mm_shuffle_epi8(_mm_loadu_si128(data + 0), mask);
+  e0 = _mm_add_epi32(e0, msg0);
+  e1 = abcd;
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+  // Rounds 4-7
+  msg1 = _mm_shuffle_epi8(_mm_loadu_si128(data + 1), mask);
+  e1 = _mm_sha1nexte_epu32(e1, msg1);
+  e0 = abcd;
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+  msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+
+  // Rounds 8-11
+  msg2 = _mm_shuffle_epi8(_mm_loadu_si128(data + 2), mask);
+  e0 = _mm_sha1nexte_epu32(e0, msg2);
+  e1 = abcd;
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+  msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+  msg0 = _mm_xor_si128(msg0, msg2);
+
+  // Rounds 12-15
+  msg3 = _mm_shuffle_epi8(_mm_loadu_si128(data + 3), mask);
+  e1 = _mm_sha1nexte_epu32(e1, msg3);
+  e0 = abcd;
+  msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+  msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+  msg1 = _mm_xor_si128(msg1, msg3);
+
+  // Rounds 16-19
+  e0 = _mm_sha1nexte_epu32(e0, msg0);
+  e1 = abcd;
+  msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+  msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+  msg2 = _mm_xor_si128(msg2, msg0);
+
+  // Rounds 20-23
+  e1 = _mm_sha1nexte_epu32(e1, msg1);
+  e0 = abcd;
+  msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+  msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+  msg3 = _mm_xor_si128(msg3, msg1);
+
+  // Rounds 24-27
+  e0 = _mm_sha1nexte_epu32(e0, msg2);
+  e1 = abcd;
+  msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+  msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+  msg0 = _mm_xor_si128(msg0, msg2);
+
+  // Rounds 28-31
+  e1 = _mm_sha1nexte_epu32(e1, msg3);
+  e0 = abcd;
+  msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+  msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+  msg1 = _mm_xor_si128(msg1, msg3);
+
+  // Rounds 32-35
+  e0 = _mm_sha1nexte_epu32(e0, msg0);
+  e1 = abcd;
+  msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+  msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+  msg2 = _mm_xor_si128(msg2, msg0);
+
+  // Rounds 36-39
+  e1 = _mm_sha1nexte_epu32(e1, msg1);
+  e0 = abcd;
+  msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+  msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+  msg3 = _mm_xor_si128(msg3, msg1);
+
+  // Rounds 40-43
+  e0 = _mm_sha1nexte_epu32(e0, msg2);
+  e1 = abcd;
+  msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+  msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+  msg0 = _mm_xor_si128(msg0, msg2);
+
+  // Rounds 44-47
+  e1 = _mm_sha1nexte_epu32(e1, msg3);
+  e0 = abcd;
+  msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+  msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+  msg1 = _mm_xor_si128(msg1, msg3);
+
+  // Rounds 48-51
+  e0 = _mm_sha1nexte_epu32(e0, msg0);
+  e1 = abcd;
+  msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+  msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+  msg2 = _mm_xor_si128(msg2, msg0);
+
+  // Rounds 52-55
+  e1 = _mm_sha1nexte_epu32(e1, msg1);
+  e0 = abcd;
+  msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+  msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+  msg3 = _mm_xor_si128(msg3, msg1);
+
+  // Rounds 56-59
+  e0 = _mm_sha1nexte_epu32(e0, msg2);
+  e1 = abcd;
+  msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+  msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+  msg0 = _mm_xor_si128(msg0, msg2);
+
+  // Rounds 60-63
+  e1 = _mm_sha1nexte_epu32(e1, msg3);
+  e0 = abcd;
+  msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+  msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+  msg1 = _mm_xor_si128(msg1, msg3);
+
+  // Rounds 64-67
+  e0 = _mm_sha1nexte_epu32(e0, msg0);
+  e1 = abcd;
+  msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+  msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+  msg2 = _mm_xor_si128(msg2, msg0);
+
+  // Rounds 68-71
+  e1 = _mm_sha1nexte_epu32(e1, msg1);
+  e0 = abcd;
+  msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+  msg3 = _mm_xor_si128(msg3, msg1);
+
+  // Rounds 72-75
+  e0 = _mm_sha1nexte_epu32(e0, msg2);
+  e1 = abcd;
+  msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+  abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+
+  // Rounds 76-79
+  e1 = _mm_sha1nexte_epu32(e1, msg3);
+  e0 = abcd;
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+
+  e0 = _mm_sha1nexte_epu32(e0, e0_save);
+  abcd = _mm_add_epi32(abcd, abcd_save);
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state),
+                   _mm_shuffle_epi32(abcd, 0x1b));
+  state[4] = _mm_extract_epi32(e0, 3);
+}
+
+alignas(16) static const uint32_t sha256_ni_k[] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+__attribute__((target("sha,sse4.1"))) static void
+sha256_ni_transform(uint32_t* state, const void* buffer)
+{
+  const auto data = reinterpret_cast<const __m128i*>(buffer);
+  const auto k = reinterpret_cast<const __m128i*>(sha256_ni_k);
+  const auto mask =
+      _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  __m128i abef, cdgh, msg, msg0, msg1, msg2, msg3;
+
+  // The SHA extensions operate on the state in ABEF/CDGH order.
+  msg = _mm_shuffle_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xb1);
+  cdgh = _mm_shuffle_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1b);
+  abef = _mm_alignr_epi8(msg, cdgh, 8);
+  cdgh = _mm_blend_epi16(cdgh, msg, 0xf0);
+
+  const auto abef_save = abef;
+  const auto cdgh_save = cdgh;
+
+  // Rounds 0-3
+  msg0 = _mm_shuffle_epi8(_mm_loadu_si128(data + 0), mask);
+  msg = _mm_add_epi32(msg0, _mm_loadu_si128(k + 0));
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg, 0x0e));
+
+  // Rounds 4-7
+  msg1 = _mm_shuffle_epi8(_mm_loadu_si128(data + 1), mask);
+  msg = _mm_add_epi32(msg1, _mm_loadu_si128(k + 1));
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg, 0x0e));
+  msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+
+  // Rounds 8-11
+  msg2 = _mm_shuffle_epi8(_mm_loadu_si128(data + 2), mask);
+  msg = _mm_add_epi32(msg2, _mm_loadu_si128(k + 2));
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg, 0x0e));
+  msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+
+  // Rounds 12-15
+  msg3 = _mm_shuffle_epi8(_mm_loadu_si128(data + 3), mask);
+  msg = _mm_add_epi32(msg3, _mm_loadu_si128(k + 3));
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+  msg0 = _mm_add_epi32(msg0, _mm_alignr_epi8(msg3, msg2, 4));
+  msg0 = _mm_sha256msg2_epu32(msg0, msg3);
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg, 0x0e));
+  msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+  // Rounds 16-19
+  msg = _mm_add_epi32(msg0, _mm_loadu_si128(k + 4));
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+  msg1 = _mm_add_epi32(msg1, _mm_alignr_epi8(msg0, msg3, 4));
+  msg1 = _mm_sha256msg2_epu32(msg1, msg0);
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg, 0x0e));
+  msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+
+  // Rounds 20-23
+  msg = _mm_add_epi32(msg1, _mm_loadu_si128(k + 5));
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+  msg2 = _mm_add_epi32(msg2, _mm_alignr_epi8(msg1, msg0, 4));
+  msg2 = _mm_sha256msg2_epu32(msg2, msg1);
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg, 0x0e));
+  msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+
+  // Rounds 24-27
+  msg = _mm_add_epi32(msg2, _mm_loadu_si128(k + 6));
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+  msg3 = _mm_add_epi32(msg3, _mm_alignr_epi8(msg2, msg1, 4));
+  msg3 = _mm_sha256msg2_epu32(msg3, msg2);
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg, 0x0e));
+  msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+
+  // Rounds 28-31
+  msg = _mm_add_epi32(msg3, _mm_loadu_si128(k + 7));
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+  msg0 = _mm_add_epi32(msg0, _mm_alignr_epi8(msg3, msg2, 4));
+  msg0 = _mm_sha256msg2_epu32(msg0, msg3);
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg, 0x0e));
+  msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+  // Rounds 32-35
+  msg = _mm_add_epi32(msg0, _mm_loadu_si128(k + 8));
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+  msg1 = _mm_add_epi32(msg1, _mm_alignr_epi8(msg0, msg3, 4));
+  msg1 = _mm_sha256msg2_epu32(msg1, msg0);
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg, 0x0e));
+  msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+
+  // Rounds 36-39
+  msg = _mm_add_epi32(msg1, _mm_loadu_si128(k + 9));
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+  msg2 = _mm_add_epi32(msg2, _mm_alignr_epi8(msg1, msg0, 4));
+  msg2 = _mm_sha256msg2_epu32(msg2, msg1);
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg, 0x0e));
+  msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+
+  // Rounds 40-43
+  msg = _mm_add_epi32(msg2, _mm_loadu_si128(k + 10));
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+  msg3 = _mm_add_epi32(msg3, _mm_alignr_epi8(msg2, msg1, 4));
+  msg3 = _mm_sha256msg2_epu32(msg3, msg2);
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg, 0x0e));
+  msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+
+  // Rounds 44-47
+  msg = _mm_add_epi32(msg3, _mm_loadu_si128(k + 11));
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+  msg0 = _mm_add_epi32(msg0, _mm_alignr_epi8(msg3, msg2, 4));
+  msg0 = _mm_sha256msg2_epu32(msg0, msg3);
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg, 0x0e));
+  msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+  // Rounds 48-51
+  msg = _mm_add_epi32(msg0, _mm_loadu_si128(k + 12));
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+  msg1 = _mm_add_epi32(msg1, _mm_alignr_epi8(msg0, msg3, 4));
+  msg1 = _mm_sha256msg2_epu32(msg1, msg0);
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg, 0x0e));
+  msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+
+  // Rounds 52-55
+  msg = _mm_add_epi32(msg1, _mm_loadu_si128(k + 13));
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+  msg2 = _mm_add_epi32(msg2, _mm_alignr_epi8(msg1, msg0, 4));
+  msg2 = _mm_sha256msg2_epu32(msg2, msg1);
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg, 0x0e));
+
+  // Rounds 56-59
+  msg = _mm_add_epi32(msg2, _mm_loadu_si128(k + 14));
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+  msg3 = _mm_add_epi32(msg3, _mm_alignr_epi8(msg2, msg1, 4));
+  msg3 = _mm_sha256msg2_epu32(msg3, msg2);
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg, 0x0e));
+
+  // Rounds 60-63
+  msg = _mm_add_epi32(msg3, _mm_loadu_si128(k + 15));
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg, 0x0e));
+
+  abef = _mm_add_epi32(abef, abef_save);
+  cdgh = _mm_add_epi32(cdgh, cdgh_save);
+
+  msg = _mm_shuffle_epi32(abef, 0x1b);
+  cdgh = _mm_shuffle_epi32(cdgh, 0xb1);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state),
+                   _mm_blend_epi16(msg, cdgh, 0xf0));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4),
+                   _mm_alignr_epi8(cdgh, msg, 8));
+}
+
+class SHA1NI : public SHA1 {
+protected:
+  virtual void transform(const word_t* buffer)
+  {
+    sha1_ni_transform(state_.words, buffer);
+  }
+};
+
+class SHA224NI : public SHA224 {
+protected:
+  virtual void transform(const word_t* buffer)
+  {
+    sha256_ni_transform(state_.words, buffer);
+  }
+};
+
+class SHA256NI : public SHA256 {
+protected:
+  virtual void transform(const word_t* buffer)
+  {
+    sha256_ni_transform(state_.words, buffer);
+  }
+};
+#endif // __hash_have_sha_ni
+
 class SHA512 : public AlgorithmImpl<uint64_t, 16, 8> {
 private:
   static const word_t initvec[];
@@ -1052,7 +1453,38 @@ Algorithms crypto::hash::lookup(const std::string& name)
   return i->second;
 }
 
+bool crypto::hash::useSHAExtensions()
+{
+#ifdef __hash_have_sha_ni
+  return use_sha_ni();
+#else  // !__hash_have_sha_ni
+  return false;
+#endif // !__hash_have_sha_ni
+}
+
 std::unique_ptr<Algorithm> crypto::hash::create(Algorithms algo)
+{
+#ifdef __hash_have_sha_ni
+  if (use_sha_ni()) {
+    switch (algo) {
+    case algoSHA1:
+      return aria2::make_unique<SHA1NI>();
+
+    case algoSHA224:
+      return aria2::make_unique<SHA224NI>();
+
+    case algoSHA256:
+      return aria2::make_unique<SHA256NI>();
+
+    default:
+      break;
+    }
+  }
+#endif // __hash_have_sha_ni
+  return createPortable(algo);
+}
+
+std::unique_ptr<Algorithm> crypto::hash::createPortable(Algorithms algo)
 {
   switch (algo) {
   case algoMD5:
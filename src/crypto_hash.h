@@ -58,6 +58,14 @@ Algorithms lookup(const std::string& name);
 
 std::unique_ptr<Algorithm> create(Algorithms algo);
 
+// Like |create|, but never uses the CPU specific implementations.
+// Mostly useful to check those against the portable ones.
+std::unique_ptr<Algorithm> createPortable(Algorithms algo);
+
+// Returns true if |create| uses the x86 SHA extensions for SHA-1,
+// SHA-224 and SHA-256 on this CPU.
+bool useSHAExtensions();
+
 inline std::unique_ptr<Algorithm> create(const std::string& name)
 {
   return create(lookup(name));
@@ -352,6 +352,8 @@ PrefPtr PREF_FORCE_SAVE = makePref("force-save");
 PrefPtr PREF_SAVE_NOT_FOUND = makePref("save-not-found");
 // value: 1*digit
 PrefPtr PREF_DISK_CACHE = makePref("disk-cache");
+// value: 1*digit
+PrefPtr PREF_DISK_READ_CACHE = makePref("disk-read-cache");
 // value: string
 PrefPtr PREF_GID = makePref("gid");
 // values: 1*digit
@@ -568,6 +570,10 @@ PrefPtr PREF_BT_ENABLE_HOOK_AFTER_HASH_CHECK =
     makePref("bt-enable-hook-after-hash-check");
 // values: true | false
 PrefPtr PREF_BT_LOAD_SAVED_METADATA = makePref("bt-load-saved-metadata");
+// values: true | false
+PrefPtr PREF_BT_SUPER_SEEDING = makePref("bt-super-seeding");
+// values: true | false
+PrefPtr PREF_BT_SEND_REDUNDANT_HAVE = makePref("bt-send-redundant-have");
 
 /**
  * Metalink related preferences
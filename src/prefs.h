@@ -305,6 +305,8 @@ extern PrefPtr PREF_FORCE_SAVE;
 extern PrefPtr PREF_SAVE_NOT_FOUND;
 // value: 1*digit
 extern PrefPtr PREF_DISK_CACHE;
+// value: 1*digit
+extern PrefPtr PREF_DISK_READ_CACHE;
 // value: string
 extern PrefPtr PREF_GID;
 // values: 1*digit
@@ -519,6 +521,10 @@ extern PrefPtr PREF_BT_FORCE_ENCRYPTION;
 extern PrefPtr PREF_BT_ENABLE_HOOK_AFTER_HASH_CHECK;
 // values: true | false
 extern PrefPtr PREF_BT_LOAD_SAVED_METADATA;
+// values: true | false
+extern PrefPtr PREF_BT_SUPER_SEEDING;
+// values: true | false
+extern PrefPtr PREF_BT_SEND_REDUNDANT_HAVE;
 
 /**
  * Metalink related preferences
@@ -729,7 +729,9 @@
   _(" --http-accept-gzip[=true|false] Send 'Accept-Encoding: deflate, gzip' request\n" \
     "                              header and inflate response if remote server\n" \
     "                              responds with 'Content-Encoding: gzip' or\n"  \
-    "                              'Content-Encoding: deflate'.")
+    "                              'Content-Encoding: deflate'. If aria2 is built\n" \
+    "                              with libbrotlidec and/or libzstd, 'br' and/or\n" \
+    "                              'zstd' are also accepted and decoded.")
 #define TEXT_SAVE_SESSION                       \
   _(" --save-session=FILE          Save error/unfinished downloads to FILE on exit.\n" \
     "                              You can pass this output file to aria2c with -i\n" \
@@ -1002,6 +1004,15 @@
     "                              cached in memory, we don't need to read them\n" \
     "                              from the disk.\n"                    \
     "                              SIZE can include K or M(1K = 1024, 1M = 1024K).")
+#define TEXT_DISK_READ_CACHE                    \
+  _(" --disk-read-cache=SIZE       Enable read cache for BitTorrent uploads. If\n" \
+    "                              SIZE is 0, the read cache is disabled. When a\n" \
+    "                              peer requests a block of a piece, the whole\n" \
+    "                              piece is read into memory and the following\n" \
+    "                              requests for the piece are served from it. The\n" \
+    "                              cache grows to at most SIZE bytes and is shared\n" \
+    "                              by all downloads.\n" \
+    "                              SIZE can include K or M(1K = 1024, 1M = 1024K).")
 #define TEXT_GID                                \
   _(" --gid=GID                    Set GID manually. aria2 identifies each\n" \
     "                              download by the ID called GID. The GID must be\n" \
@@ -1129,5 +1140,18 @@
     "                              file saved by --bt-save-metadata option. If it is\n" \
     "                              successful, then skip downloading metadata from\n" \
     "                              DHT.")
+#define TEXT_BT_SUPER_SEEDING                                           \
+  _(" --bt-super-seeding[=true|false] Enable super seeding. When aria2 has all\n" \
+    "                              pieces, it reveals one piece at a time to each\n" \
+    "                              peer instead of advertising all of them, and\n" \
+    "                              reveals the next one only after the previous\n" \
+    "                              one was seen at another peer. This reduces the\n" \
+    "                              duplicate data uploaded by the initial seeder.")
+#define TEXT_BT_SEND_REDUNDANT_HAVE \
+  _(" --bt-send-redundant-have[=true|false]\n" \
+    "                              Send have messages to the peers which already\n" \
+    "                              have the pieces. If false is given, these have\n" \
+    "                              messages are suppressed to save upload\n" \
+    "                              bandwidth.")
 
 // clang-format on
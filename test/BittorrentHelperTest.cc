@@ -49,6 +49,7 @@ class BittorrentHelperTest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testGetFileEntries_singleFileUrlListEndsWithSlash);
   CPPUNIT_TEST(testLoadFromMemory);
   CPPUNIT_TEST(testLoadFromMemory_somethingMissing);
+  CPPUNIT_TEST(testLoadFromMemory_metaVersion2);
   CPPUNIT_TEST(testLoadFromMemory_overrideName);
   CPPUNIT_TEST(testLoadFromMemory_multiFileDirTraversal);
   CPPUNIT_TEST(testLoadFromMemory_singleFileDirTraversal);
@@ -108,6 +109,7 @@ public:
   void testGetFileEntries_singleFileUrlListEndsWithSlash();
   void testLoadFromMemory();
   void testLoadFromMemory_somethingMissing();
+  void testLoadFromMemory_metaVersion2();
   void testLoadFromMemory_overrideName();
   void testLoadFromMemory_multiFileDirTraversal();
   void testLoadFromMemory_singleFileDirTraversal();
@@ -526,6 +528,39 @@ void BittorrentHelperTest::testLoadFromMemory_somethingMissing()
   }
 }
 
+void BittorrentHelperTest::testLoadFromMemory_metaVersion2()
+{
+  // v2-only torrent
+  try {
+    std::string memory = "d4:infod9:file treed9:aria2.txtd0:d6:lengthi100e"
+                         "11:pieces root32:"
+                         "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAeee"
+                         "12:meta versioni2e4:name9:aria2.txt"
+                         "12:piece lengthi16384eee";
+    auto dctx = std::make_shared<DownloadContext>();
+    loadFromMemory(memory, dctx, option_, "default");
+    CPPUNIT_FAIL("exception must be thrown.");
+  }
+  catch (Exception& e) {
+    CPPUNIT_ASSERT_EQUAL(
+        std::string("BitTorrent v2-only torrent is not supported."),
+        std::string(e.what()));
+    CPPUNIT_ASSERT_EQUAL(error_code::BITTORRENT_PARSE_ERROR, e.getErrorCode());
+  }
+  // hybrid torrent is loaded as v1 torrent
+  std::string memory = "d4:infod9:file treed9:aria2.txtd0:d6:lengthi100e"
+                       "11:pieces root32:"
+                       "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAeee"
+                       "6:lengthi100e"
+                       "12:meta versioni2e4:name9:aria2.txt"
+                       "12:piece lengthi16384e"
+                       "6:pieces20:AAAAAAAAAAAAAAAAAAAAee";
+  auto dctx = std::make_shared<DownloadContext>();
+  loadFromMemory(memory, dctx, option_, "default");
+  CPPUNIT_ASSERT_EQUAL((size_t)1, dctx->getNumPieces());
+  CPPUNIT_ASSERT_EQUAL((int64_t)100, dctx->getTotalLength());
+}
+
 void BittorrentHelperTest::testLoadFromMemory_overrideName()
 {
   std::string memory = "d8:announce36:http://aria.rednoah.com/"
@@ -16,6 +16,18 @@
 #include "BtHandshakeMessage.h"
 #include "DownloadContext.h"
 #include "BtRejectMessage.h"
+#include "DefaultPieceStorage.h"
+#include "DefaultPeerStorage.h"
+#include "MockBtRequestFactory.h"
+#include "ByteArrayDiskWriterFactory.h"
+#include "DiskAdaptor.h"
+#include "MessageDigest.h"
+#include "RequestSlot.h"
+#include "SmartBan.h"
+#include "Option.h"
+#include "RequestGroup.h"
+#include "GroupId.h"
+#include "DlAbortEx.h"
 
 namespace aria2 {
 
@@ -33,6 +45,8 @@ class BtPieceMessageTest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testCancelSendingPieceEvent_allowedFastEnabled);
   CPPUNIT_TEST(testCancelSendingPieceEvent_invalidate);
   CPPUNIT_TEST(testToString);
+  CPPUNIT_TEST(testDoReceivedAction_smartBan);
+  CPPUNIT_TEST(testDoReceivedAction_unknownContributor);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -48,6 +62,8 @@ public:
   void testCancelSendingPieceEvent_allowedFastEnabled();
   void testCancelSendingPieceEvent_invalidate();
   void testToString();
+  void testDoReceivedAction_smartBan();
+  void testDoReceivedAction_unknownContributor();
 
   class MockBtMessageFactory2 : public MockBtMessageFactory {
   public:
@@ -59,6 +75,78 @@ public:
     }
   };
 
+  class MockBtMessageDispatcher2 : public MockBtMessageDispatcher {
+  public:
+    std::unique_ptr<RequestSlot> slot;
+
+    // Every block is taken as requested.
+    virtual const RequestSlot*
+    getOutstandingRequest(size_t index, int32_t begin,
+                          int32_t length) CXX11_OVERRIDE
+    {
+      slot = make_unique<RequestSlot>(index, begin, length, begin / 16_k);
+      return slot.get();
+    }
+  };
+
+  std::shared_ptr<Option> option_;
+  std::unique_ptr<RequestGroup> requestGroup_;
+  std::shared_ptr<DownloadContext> pieceDctx_;
+  std::shared_ptr<DefaultPieceStorage> pieceStorage_;
+  std::unique_ptr<DefaultPeerStorage> peerStorage_;
+  MockBtMessageDispatcher2 btMessageDispatcher2_;
+  MockBtRequestFactory btRequestFactory_;
+
+  void setUpPieceStorage()
+  {
+    // 1 piece of 2 blocks.  The correct data is 16KiB of 'a' followed
+    // by 16KiB of 'b'.
+    pieceDctx_ = std::make_shared<DownloadContext>(
+        32_k, 32_k, A2_TEST_OUT_DIR "/aria2_BtPieceMessageTest");
+    auto md = MessageDigest::sha1();
+    md->update(std::string(16_k, 'a').data(), 16_k);
+    md->update(std::string(16_k, 'b').data(), 16_k);
+    auto hashes = std::vector<std::string>{md->digest()};
+    pieceDctx_->setPieceHashes("sha-1", std::begin(hashes), std::end(hashes));
+    option_ = std::make_shared<Option>();
+    requestGroup_ = make_unique<RequestGroup>(GroupId::create(), option_);
+    pieceDctx_->setOwnerRequestGroup(requestGroup_.get());
+    pieceStorage_ =
+        std::make_shared<DefaultPieceStorage>(pieceDctx_, option_.get());
+    pieceStorage_->setDiskWriterFactory(
+        std::make_shared<ByteArrayDiskWriterFactory>());
+    pieceStorage_->initStorage();
+    pieceStorage_->getDiskAdaptor()->initAndOpenFile();
+    peerStorage_ = make_unique<DefaultPeerStorage>();
+  }
+
+  std::shared_ptr<Peer> createPeer(const std::string& ipaddr)
+  {
+    auto peer = std::make_shared<Peer>(ipaddr, 6881);
+    peer->allocateSessionResource(pieceDctx_->getPieceLength(),
+                                  pieceDctx_->getTotalLength());
+    peer->setAllBitfield();
+    return peer;
+  }
+
+  // Receives the block |blockIndex| of piece 0 filled with |c| from
+  // |peer|.
+  void receiveBlock(const std::shared_ptr<Peer>& peer, size_t blockIndex,
+                    char c)
+  {
+    auto payload = std::string(9 + 16_k, c);
+    BtPieceMessage m(0, blockIndex * 16_k, 16_k);
+    m.setMsgPayload(reinterpret_cast<const unsigned char*>(payload.data()));
+    m.setDownloadContext(pieceDctx_.get());
+    m.setPeer(peer);
+    m.setBtMessageDispatcher(&btMessageDispatcher2_);
+    m.setBtMessageFactory(btMessageFactory_.get());
+    m.setBtRequestFactory(&btRequestFactory_);
+    m.setPieceStorage(pieceStorage_.get());
+    m.setPeerStorage(peerStorage_.get());
+    m.doReceivedAction();
+  }
+
   std::unique_ptr<DownloadContext> dctx_;
   std::unique_ptr<MockBtMessageDispatcher> btMessageDispatcher;
   std::unique_ptr<MockBtMessageFactory> btMessageFactory_;
@@ -262,4 +350,67 @@ void BtPieceMessageTest::testToString()
                        msg->toString());
 }
 
+void BtPieceMessageTest::testDoReceivedAction_smartBan()
+{
+  setUpPieceStorage();
+  auto peer1 = createPeer("192.168.0.1");
+  auto peer2 = createPeer("192.168.0.2");
+  auto peer3 = createPeer("192.168.0.3");
+  for (int i = 0; i < 3; ++i) {
+    pieceStorage_->addPieceStats(0);
+  }
+  auto piece = pieceStorage_->getMissingPiece(0, 1);
+
+  // peer2 sends corrupt data.  It is not known yet which peer is to
+  // blame, so nobody is banned, however many times the piece fails.
+  for (int i = 0; i < 10; ++i) {
+    receiveBlock(peer1, 0, 'a');
+    receiveBlock(peer2, 1, 'x');
+    CPPUNIT_ASSERT(!pieceStorage_->hasPiece(0));
+    CPPUNIT_ASSERT_EQUAL((int64_t)0, piece->getCompletedLength());
+    CPPUNIT_ASSERT(!peerStorage_->isBadPeer("192.168.0.1"));
+    CPPUNIT_ASSERT(!peerStorage_->isBadPeer("192.168.0.2"));
+  }
+  auto smartBan = pieceStorage_->getSmartBan();
+  CPPUNIT_ASSERT(smartBan->hasRecord(0));
+
+  // The piece is not given to peer1 and peer2 again, because peer3
+  // has it.
+  pieceStorage_->cancelPiece(piece, 1);
+  std::vector<std::shared_ptr<Piece>> pieces;
+  pieceStorage_->getMissingPiece(pieces, 1, peer1, 1);
+  CPPUNIT_ASSERT(pieces.empty());
+  pieceStorage_->getMissingPiece(pieces, 1, peer2, 2);
+  CPPUNIT_ASSERT(pieces.empty());
+  pieceStorage_->getMissingPiece(pieces, 1, peer3, 3);
+  CPPUNIT_ASSERT_EQUAL((size_t)1, pieces.size());
+
+  receiveBlock(peer3, 0, 'a');
+  receiveBlock(peer3, 1, 'b');
+  CPPUNIT_ASSERT(pieceStorage_->hasPiece(0));
+  // Only peer2 sent data which differs from the correct piece.
+  CPPUNIT_ASSERT(!peerStorage_->isBadPeer("192.168.0.1"));
+  CPPUNIT_ASSERT(peerStorage_->isBadPeer("192.168.0.2"));
+  CPPUNIT_ASSERT(!peerStorage_->isBadPeer("192.168.0.3"));
+  CPPUNIT_ASSERT(!smartBan->hasRecord(0));
+}
+
+void BtPieceMessageTest::testDoReceivedAction_unknownContributor()
+{
+  setUpPieceStorage();
+  auto peer1 = createPeer("192.168.0.1");
+  auto piece = pieceStorage_->getMissingPiece(0, 1);
+  // Nobody is known to have sent block 0, for example when it was
+  // loaded from a control file.  peer1 is the sole contributor.
+  piece->completeBlock(0);
+  try {
+    receiveBlock(peer1, 1, 'x');
+    CPPUNIT_FAIL("exception must be thrown.");
+  }
+  catch (DlAbortEx& e) {
+    CPPUNIT_ASSERT_EQUAL(std::string("Bad piece hash."), std::string(e.what()));
+  }
+  CPPUNIT_ASSERT(peerStorage_->isBadPeer("192.168.0.1"));
+}
+
 } // namespace aria2
@@ -30,6 +30,8 @@ class BtRequestMessageTest : public CppUnit::TestFixture {
       testDoReceivedAction_hasPieceAndAmChokingAndFastExtensionDisabled);
   CPPUNIT_TEST(testDoReceivedAction_doesntHavePieceAndFastExtensionEnabled);
   CPPUNIT_TEST(testDoReceivedAction_doesntHavePieceAndFastExtensionDisabled);
+  CPPUNIT_TEST(testDoReceivedAction_superSeeding);
+  CPPUNIT_TEST(testDoReceivedAction_superSeedingAndFastExtensionEnabled);
   CPPUNIT_TEST(testHandleAbortRequestEvent);
   CPPUNIT_TEST(testHandleAbortRequestEvent_indexNoMatch);
   CPPUNIT_TEST(testHandleAbortRequestEvent_alreadyInvalidated);
@@ -47,6 +49,8 @@ public:
   void testDoReceivedAction_hasPieceAndAmChokingAndFastExtensionDisabled();
   void testDoReceivedAction_doesntHavePieceAndFastExtensionEnabled();
   void testDoReceivedAction_doesntHavePieceAndFastExtensionDisabled();
+  void testDoReceivedAction_superSeeding();
+  void testDoReceivedAction_superSeedingAndFastExtensionEnabled();
   void testHandleAbortRequestEvent();
   void testHandleAbortRequestEvent_indexNoMatch();
   void testHandleAbortRequestEvent_alreadyInvalidated();
@@ -225,6 +229,40 @@ void BtRequestMessageTest::
   CPPUNIT_ASSERT_EQUAL((size_t)0, dispatcher_->messageQueue.size());
 }
 
+void BtRequestMessageTest::testDoReceivedAction_superSeeding()
+{
+  peer_->amChoking(false);
+  peer_->setSuperSeeding(true);
+  // The piece has not been revealed to the peer.
+  msg->doReceivedAction();
+
+  CPPUNIT_ASSERT_EQUAL((size_t)0, dispatcher_->messageQueue.size());
+
+  peer_->addSuperSeedingIndex(1);
+  msg->doReceivedAction();
+
+  CPPUNIT_ASSERT_EQUAL((size_t)1, dispatcher_->messageQueue.size());
+  CPPUNIT_ASSERT(BtPieceMessage::ID ==
+                 dispatcher_->messageQueue.front()->getId());
+}
+
+void BtRequestMessageTest::
+    testDoReceivedAction_superSeedingAndFastExtensionEnabled()
+{
+  peer_->amChoking(false);
+  peer_->setFastExtensionEnabled(true);
+  peer_->setSuperSeeding(true);
+  peer_->addSuperSeedingIndex(0);
+  msg->doReceivedAction();
+
+  CPPUNIT_ASSERT_EQUAL((size_t)1, dispatcher_->messageQueue.size());
+  CPPUNIT_ASSERT(BtRejectMessage::ID ==
+                 dispatcher_->messageQueue.front()->getId());
+  auto rejectMsg = static_cast<const BtRejectMessage*>(
+      dispatcher_->messageQueue.front().get());
+  CPPUNIT_ASSERT_EQUAL((size_t)1, rejectMsg->getIndex());
+}
+
 void BtRequestMessageTest::testHandleAbortRequestEvent()
 {
   auto piece = std::make_shared<Piece>(1, 16_k);
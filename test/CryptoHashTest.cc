@@ -0,0 +1,73 @@
+#include "crypto_hash.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "a2functional.h"
+#include "fmt.h"
+#include "util.h"
+
+namespace aria2 {
+
+class CryptoHashTest : public CppUnit::TestFixture {
+
+  CPPUNIT_TEST_SUITE(CryptoHashTest);
+  CPPUNIT_TEST(testSHAExtensions);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp() {}
+
+  void tearDown() {}
+
+  void testSHAExtensions();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(CryptoHashTest);
+
+namespace {
+std::string digest(std::unique_ptr<crypto::hash::Algorithm> ctx,
+                   const std::string& data, size_t chunk)
+{
+  for (size_t i = 0; i < data.size(); i += chunk) {
+    ctx->update(data.data() + i, std::min(chunk, data.size() - i));
+  }
+  return util::toHex(ctx->finalize());
+}
+} // namespace
+
+void CryptoHashTest::testSHAExtensions()
+{
+  if (!crypto::hash::useSHAExtensions()) {
+    std::cerr << "SHA extensions are not available. Skipped." << std::endl;
+    return;
+  }
+  std::string data(4_k + 17, '\0');
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>(i * 7 + (i >> 8));
+  }
+  // Around the block size and the padding boundary, and a few blocks.
+  const size_t lens[] = {0,  1,   3,   55,  56,   63,   64,
+                         65, 119, 120, 128, 1000, 4096, 4096 + 17};
+  // Feeding the data in chunks covers both buffered and direct
+  // transforms.
+  const size_t chunks[] = {1, 13, 64, 100, 4_k + 17};
+  for (auto algo : {crypto::hash::algoSHA1, crypto::hash::algoSHA224,
+                    crypto::hash::algoSHA256}) {
+    for (auto len : lens) {
+      auto in = data.substr(0, len);
+      auto expected = digest(crypto::hash::createPortable(algo), in, len + 1);
+      for (auto chunk : chunks) {
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(
+            fmt("algo=%d len=%lu chunk=%lu", algo,
+                static_cast<unsigned long>(len),
+                static_cast<unsigned long>(chunk)),
+            expected, digest(crypto::hash::create(algo), in, chunk));
+      }
+    }
+  }
+}
+
+} // namespace aria2
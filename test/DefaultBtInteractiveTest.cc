@@ -0,0 +1,389 @@
+#include "DefaultBtInteractive.h"
+
+#include <deque>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "MockBtMessageDispatcher.h"
+#include "MockBtMessageFactory.h"
+#include "MockBtRequestFactory.h"
+#include "BtMessageReceiver.h"
+#include "BtHandshakeMessage.h"
+#include "DefaultPieceStorage.h"
+#include "DownloadContext.h"
+#include "Peer.h"
+#include "Option.h"
+#include "BtRuntime.h"
+#include "RequestGroup.h"
+#include "RequestGroupMan.h"
+#include "GroupId.h"
+#include "BtConstants.h"
+#include "wallclock.h"
+#include "DlAbortEx.h"
+#include "BtHaveMessage.h"
+#include "BtBitfieldMessage.h"
+#include "a2functional.h"
+
+namespace aria2 {
+
+class DefaultBtInteractiveTest : public CppUnit::TestFixture {
+
+  CPPUNIT_TEST_SUITE(DefaultBtInteractiveTest);
+  CPPUNIT_TEST(testCheckHave);
+  CPPUNIT_TEST(testCheckHave_noRedundantHave);
+  CPPUNIT_TEST(testCheckHave_allSuppressed);
+  CPPUNIT_TEST(testUpdateMaxOutstandingRequest);
+  CPPUNIT_TEST(testRevealSuperSeedingPiece);
+  CPPUNIT_TEST(testRevealSuperSeedingPiece_singlePeer);
+  CPPUNIT_TEST(testRevealSuperSeedingPiece_rotate);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  class MockBtMessageFactory2 : public MockBtMessageFactory {
+  public:
+    virtual std::unique_ptr<BtHaveMessage>
+    createHaveMessage(size_t index) CXX11_OVERRIDE
+    {
+      return make_unique<BtHaveMessage>(index);
+    }
+
+    virtual std::unique_ptr<BtBitfieldMessage>
+    createBitfieldMessage() CXX11_OVERRIDE
+    {
+      return make_unique<BtBitfieldMessage>();
+    }
+  };
+
+  class MockBtMessageReceiver : public BtMessageReceiver {
+  public:
+    virtual std::unique_ptr<BtHandshakeMessage>
+    receiveHandshake(bool quickReply = false) CXX11_OVERRIDE
+    {
+      return nullptr;
+    }
+
+    virtual std::unique_ptr<BtHandshakeMessage>
+    receiveAndSendHandshake() CXX11_OVERRIDE
+    {
+      return nullptr;
+    }
+
+    virtual std::unique_ptr<BtMessage> receiveMessage() CXX11_OVERRIDE
+    {
+      return nullptr;
+    }
+  };
+
+  std::shared_ptr<Option> option_;
+  std::unique_ptr<RequestGroup> requestGroup_;
+  std::unique_ptr<RequestGroupMan> rgman_;
+  std::shared_ptr<DownloadContext> dctx_;
+  std::shared_ptr<DefaultPieceStorage> pieceStorage_;
+  std::shared_ptr<BtRuntime> btRuntime_;
+  std::shared_ptr<Peer> peer_;
+  std::unique_ptr<DefaultBtInteractive> btInteractive_;
+  MockBtMessageDispatcher* dispatcher_;
+
+public:
+  void setUp()
+  {
+    option_ = std::make_shared<Option>();
+    requestGroup_ = make_unique<RequestGroup>(GroupId::create(), option_);
+    rgman_ = make_unique<RequestGroupMan>(
+        std::vector<std::shared_ptr<RequestGroup>>{}, 1, option_.get());
+    // 1000 pieces, so that a few have messages are cheaper than a
+    // bitfield message.
+    dctx_ = std::make_shared<DownloadContext>(16_k, 16_k * 1000);
+    requestGroup_->setDownloadContext(dctx_);
+    pieceStorage_ = std::make_shared<DefaultPieceStorage>(dctx_, option_.get());
+    btRuntime_ = std::make_shared<BtRuntime>();
+    btRuntime_->increaseConnections();
+    btRuntime_->increaseConnections();
+    peer_ = createPeer("192.168.0.1");
+    btInteractive_ = createBtInteractive(peer_, dispatcher_);
+  }
+
+  std::shared_ptr<Peer> createPeer(const std::string& ipaddr)
+  {
+    auto peer = std::make_shared<Peer>(ipaddr, 6969);
+    peer->allocateSessionResource(dctx_->getPieceLength(),
+                                  dctx_->getTotalLength());
+    return peer;
+  }
+
+  std::unique_ptr<DefaultBtInteractive>
+  createBtInteractive(const std::shared_ptr<Peer>& peer,
+                      MockBtMessageDispatcher*& dispatcherPtr)
+  {
+    auto btInteractive = make_unique<DefaultBtInteractive>(dctx_, peer);
+    btInteractive->setCuid(1);
+    btInteractive->setPieceStorage(pieceStorage_);
+    btInteractive->setBtRuntime(btRuntime_);
+    auto dispatcher = make_unique<MockBtMessageDispatcher>();
+    dispatcherPtr = dispatcher.get();
+    btInteractive->setDispatcher(std::move(dispatcher));
+    btInteractive->setBtMessageFactory(make_unique<MockBtMessageFactory2>());
+    btInteractive->setBtMessageReceiver(make_unique<MockBtMessageReceiver>());
+    btInteractive->setBtRequestFactory(make_unique<MockBtRequestFactory>());
+    btInteractive->setRequestGroupMan(rgman_.get());
+    return btInteractive;
+  }
+
+  void testCheckHave();
+  void testCheckHave_noRedundantHave();
+  void testCheckHave_allSuppressed();
+  void testUpdateMaxOutstandingRequest();
+  void testRevealSuperSeedingPiece();
+  void testRevealSuperSeedingPiece_singlePeer();
+  void testRevealSuperSeedingPiece_rotate();
+
+  // Runs an iteration of the interaction with the peer, and returns
+  // the have and bitfield messages queued.  Other messages are
+  // dropped.
+  std::vector<std::unique_ptr<BtMessage>>
+  interact(DefaultBtInteractive& btInteractive,
+           MockBtMessageDispatcher* dispatcher)
+  {
+    btInteractive.doInteractionProcessing();
+    std::vector<std::unique_ptr<BtMessage>> res;
+    for (auto& msg : dispatcher->messageQueue) {
+      if (dynamic_cast<BtHaveMessage*>(msg.get()) ||
+          dynamic_cast<BtBitfieldMessage*>(msg.get())) {
+        res.push_back(std::move(msg));
+      }
+    }
+    dispatcher->messageQueue.clear();
+    return res;
+  }
+
+  std::vector<std::unique_ptr<BtMessage>> interact()
+  {
+    return interact(*btInteractive_, dispatcher_);
+  }
+
+  void startSuperSeeding(DefaultBtInteractive& btInteractive,
+                         MockBtMessageDispatcher* dispatcher)
+  {
+    btInteractive.setSuperSeeding(true);
+    btInteractive.doPostHandshakeProcessing();
+    dispatcher->messageQueue.clear();
+  }
+
+  size_t getHaveIndex(const std::unique_ptr<BtMessage>& msg)
+  {
+    auto haveMsg = dynamic_cast<BtHaveMessage*>(msg.get());
+    CPPUNIT_ASSERT(haveMsg);
+    return haveMsg->getIndex();
+  }
+
+  // Runs an iteration of the interaction with the peer, and returns
+  // the index of the piece revealed.
+  size_t interactAndGetRevealedPiece(DefaultBtInteractive& btInteractive,
+                                     MockBtMessageDispatcher* dispatcher)
+  {
+    auto msgs = interact(btInteractive, dispatcher);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, msgs.size());
+    return getHaveIndex(msgs[0]);
+  }
+
+  size_t interactAndGetRevealedPiece()
+  {
+    return interactAndGetRevealedPiece(*btInteractive_, dispatcher_);
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(DefaultBtInteractiveTest);
+
+void DefaultBtInteractiveTest::testCheckHave()
+{
+  // By default, have messages are sent even if the peer already has
+  // the pieces.
+  for (size_t i = 0; i < 3; ++i) {
+    pieceStorage_->advertisePiece(2, i, global::wallclock());
+  }
+  peer_->updateBitfield(0, 1);
+  peer_->updateBitfield(2, 1);
+  auto msgs = interact();
+
+  CPPUNIT_ASSERT_EQUAL((size_t)3, msgs.size());
+  for (size_t i = 0; i < 3; ++i) {
+    CPPUNIT_ASSERT_EQUAL(i, getHaveIndex(msgs[i]));
+  }
+  CPPUNIT_ASSERT_EQUAL((size_t)0, btInteractive_->countSuppressedHave());
+
+  // Only the pieces advertised since the last call are considered.
+  pieceStorage_->advertisePiece(2, 100, global::wallclock());
+  msgs = interact();
+
+  CPPUNIT_ASSERT_EQUAL((size_t)1, msgs.size());
+  CPPUNIT_ASSERT_EQUAL((size_t)100, getHaveIndex(msgs[0]));
+}
+
+void DefaultBtInteractiveTest::testCheckHave_noRedundantHave()
+{
+  btInteractive_->setSendRedundantHave(false);
+  // 20 have messages cost more than a bitfield message, but the peer
+  // already has 18 of the pieces.
+  for (size_t i = 0; i < 20; ++i) {
+    pieceStorage_->advertisePiece(2, i, global::wallclock());
+    if (i != 5 && i != 7) {
+      peer_->updateBitfield(i, 1);
+    }
+  }
+  auto msgs = interact();
+
+  CPPUNIT_ASSERT_EQUAL((size_t)2, msgs.size());
+  CPPUNIT_ASSERT_EQUAL((size_t)5, getHaveIndex(msgs[0]));
+  CPPUNIT_ASSERT_EQUAL((size_t)7, getHaveIndex(msgs[1]));
+  CPPUNIT_ASSERT_EQUAL((size_t)18, btInteractive_->countSuppressedHave());
+
+  // Only the pieces advertised since the last call are considered.
+  pieceStorage_->advertisePiece(2, 100, global::wallclock());
+  msgs = interact();
+
+  CPPUNIT_ASSERT_EQUAL((size_t)1, msgs.size());
+  CPPUNIT_ASSERT_EQUAL((size_t)100, getHaveIndex(msgs[0]));
+  CPPUNIT_ASSERT_EQUAL((size_t)18, btInteractive_->countSuppressedHave());
+}
+
+void DefaultBtInteractiveTest::testCheckHave_allSuppressed()
+{
+  btInteractive_->setSendRedundantHave(false);
+  peer_->updateBitfield(3, 1);
+  pieceStorage_->advertisePiece(2, 3, global::wallclock());
+
+  CPPUNIT_ASSERT(interact().empty());
+  CPPUNIT_ASSERT_EQUAL((size_t)1, btInteractive_->countSuppressedHave());
+
+  // Without suppression, 20 have messages are replaced with a
+  // bitfield message.
+  for (size_t i = 10; i < 30; ++i) {
+    pieceStorage_->advertisePiece(2, i, global::wallclock());
+  }
+  auto msgs = interact();
+
+  CPPUNIT_ASSERT_EQUAL((size_t)1, msgs.size());
+  CPPUNIT_ASSERT(dynamic_cast<BtBitfieldMessage*>(msgs[0].get()));
+  CPPUNIT_ASSERT_EQUAL((size_t)1, btInteractive_->countSuppressedHave());
+}
+
+void DefaultBtInteractiveTest::testUpdateMaxOutstandingRequest()
+{
+  // Nothing downloaded from the peer yet.
+  global::wallclock().advance(1_s);
+  interact();
+  CPPUNIT_ASSERT_EQUAL(DEFAULT_MAX_OUTSTANDING_REQUEST,
+                       peer_->getMaxOutstandingRequest());
+
+  // 100 blocks in 2 seconds.  REQUEST_QUEUE_TIME seconds of the
+  // download speed is 150 blocks.
+  peer_->updateDownload(100 * 16_k);
+  global::wallclock().advance(2_s);
+  interact();
+  CPPUNIT_ASSERT_EQUAL((size_t)150, peer_->getMaxOutstandingRequest());
+
+  // Capped by the reqq value the peer advertised.
+  peer_->setReqq(50);
+  global::wallclock().advance(1_s);
+  interact();
+  CPPUNIT_ASSERT_EQUAL((size_t)50, peer_->getMaxOutstandingRequest());
+
+  // Capped by UB_MAX_OUTSTANDING_REQUEST if the peer did not
+  // advertise reqq.
+  peer_->setReqq(0);
+  peer_->updateDownload(1000 * 16_k);
+  global::wallclock().advance(1_s);
+  interact();
+  CPPUNIT_ASSERT_EQUAL(UB_MAX_OUTSTANDING_REQUEST,
+                       peer_->getMaxOutstandingRequest());
+
+  // The download from the peer has stopped, but the number of
+  // requests does not drop below DEFAULT_MAX_OUTSTANDING_REQUEST.
+  global::wallclock().advance(11_s);
+  interact();
+  CPPUNIT_ASSERT_EQUAL(DEFAULT_MAX_OUTSTANDING_REQUEST,
+                       peer_->getMaxOutstandingRequest());
+}
+
+void DefaultBtInteractiveTest::testRevealSuperSeedingPiece()
+{
+  // Unlike markAllPiecesDone(), setBitfield() counts our own pieces in
+  // the piece statistics.
+  std::vector<unsigned char> bitfield(pieceStorage_->getBitfieldLength(), 0xff);
+  pieceStorage_->setBitfield(bitfield.data(), bitfield.size());
+  startSuperSeeding(*btInteractive_, dispatcher_);
+  CPPUNIT_ASSERT(peer_->isSuperSeeding());
+  size_t index = interactAndGetRevealedPiece();
+  CPPUNIT_ASSERT(peer_->isInSuperSeedingIndexSet(index));
+
+  // The peer has not downloaded the piece yet.
+  CPPUNIT_ASSERT(interact().empty());
+
+  // The peer has it, but no other peer has got it from the peer.
+  // Our own copy does not count.
+  peer_->updateBitfield(index, 1);
+  pieceStorage_->addPieceStats(index);
+  CPPUNIT_ASSERT(interact().empty());
+
+  // Another peer has it now.
+  pieceStorage_->addPieceStats(index);
+  size_t next = interactAndGetRevealedPiece();
+  CPPUNIT_ASSERT(index != next);
+  // The piece revealed earlier is still served.
+  CPPUNIT_ASSERT(peer_->isInSuperSeedingIndexSet(index));
+  CPPUNIT_ASSERT(peer_->isInSuperSeedingIndexSet(next));
+
+  // Nothing is revealed to a seeder.  The connection is dropped
+  // instead, because we are seeding too.
+  peer_->setAllBitfield();
+  pieceStorage_->addPieceStats(next);
+  pieceStorage_->addPieceStats(next);
+  try {
+    interact();
+    CPPUNIT_FAIL("exception must be thrown.");
+  }
+  catch (DlAbortEx& e) {
+  }
+  CPPUNIT_ASSERT(dispatcher_->messageQueue.empty());
+}
+
+void DefaultBtInteractiveTest::testRevealSuperSeedingPiece_singlePeer()
+{
+  btRuntime_->decreaseConnections();
+  pieceStorage_->markAllPiecesDone();
+  startSuperSeeding(*btInteractive_, dispatcher_);
+  size_t index = interactAndGetRevealedPiece();
+
+  // With only one peer connected, the next piece is revealed as soon
+  // as the peer has downloaded the last one.
+  peer_->updateBitfield(index, 1);
+  pieceStorage_->addPieceStats(index);
+  CPPUNIT_ASSERT(index != interactAndGetRevealedPiece());
+}
+
+void DefaultBtInteractiveTest::testRevealSuperSeedingPiece_rotate()
+{
+  pieceStorage_->markAllPiecesDone();
+  // The pieces 2 peers already have are revealed last.
+  for (size_t i = 0; i < 1000; ++i) {
+    if (i != 10 && i != 20) {
+      pieceStorage_->addPieceStats(i);
+      pieceStorage_->addPieceStats(i);
+    }
+  }
+  startSuperSeeding(*btInteractive_, dispatcher_);
+  size_t first = interactAndGetRevealedPiece();
+  CPPUNIT_ASSERT(first == 10 || first == 20);
+
+  // The other equally rare piece is revealed to the next peer.
+  auto peer2 = createPeer("192.168.0.2");
+  MockBtMessageDispatcher* dispatcher2;
+  auto btInteractive2 = createBtInteractive(peer2, dispatcher2);
+  startSuperSeeding(*btInteractive2, dispatcher2);
+  CPPUNIT_ASSERT_EQUAL((size_t)30 - first,
+                       interactAndGetRevealedPiece(*btInteractive2,
+                                                   dispatcher2));
+  CPPUNIT_ASSERT(!peer2->isInSuperSeedingIndexSet(first));
+}
+
+} // namespace aria2
@@ -12,6 +12,7 @@
 #include "MockExtensionMessageFactory.h"
 #include "BtExtendedMessage.h"
 #include "BtPortMessage.h"
+#include "BtHaveMessage.h"
 #include "Exception.h"
 #include "FileEntry.h"
 
@@ -22,6 +23,7 @@ class DefaultBtMessageFactoryTest : public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(DefaultBtMessageFactoryTest);
   CPPUNIT_TEST(testCreateBtMessage_BtExtendedMessage);
   CPPUNIT_TEST(testCreatePortMessage);
+  CPPUNIT_TEST(testCreateBtMessage_validate);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -49,6 +51,7 @@ public:
 
   void testCreateBtMessage_BtExtendedMessage();
   void testCreatePortMessage();
+  void testCreateBtMessage_validate();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(DefaultBtMessageFactoryTest);
@@ -98,4 +101,23 @@ void DefaultBtMessageFactoryTest::testCreatePortMessage()
   }
 }
 
+void DefaultBtMessageFactoryTest::testCreateBtMessage_validate()
+{
+  unsigned char data[9];
+  bittorrent::createPeerMessageString(data, sizeof(data), 5, 4);
+  bittorrent::setIntParam(&data[5], 0);
+  // No piece in dctx_, so index 0 is out of range.
+  try {
+    factory_->createBtMessage(&data[4], sizeof(data) - 4);
+    CPPUNIT_FAIL("exception must be thrown.");
+  }
+  catch (Exception& e) {
+    std::cerr << e.stackTrace() << std::endl;
+  }
+  // Validation is skipped in metadata get mode.
+  factory_->enableMetadataGetMode();
+  auto m = factory_->createBtMessage(&data[4], sizeof(data) - 4);
+  CPPUNIT_ASSERT(BtHaveMessage::ID == m->getId());
+}
+
 } // namespace aria2
@@ -1,7 +1,11 @@
 #include "DefaultDiskWriter.h"
 #include <cppunit/extensions/HelperMacros.h>
 
+#include <algorithm>
+
+#include "TestUtil.h"
 #include "a2functional.h"
+#include "a2netcompat.h"
 
 namespace aria2 {
 
@@ -9,6 +13,8 @@ class DefaultDiskWriterTest : public CppUnit::TestFixture {
 
   CPPUNIT_TEST_SUITE(DefaultDiskWriterTest);
   CPPUNIT_TEST(testSize);
+  CPPUNIT_TEST(testWriteDataVector);
+  CPPUNIT_TEST(testWriteDataVector_overIovMax);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -16,6 +22,8 @@ public:
   void setUp() {}
 
   void testSize();
+  void testWriteDataVector();
+  void testWriteDataVector_overIovMax();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(DefaultDiskWriterTest);
@@ -28,4 +36,61 @@ void DefaultDiskWriterTest::testSize()
   CPPUNIT_ASSERT_EQUAL((int64_t)4_k, dw.size());
 }
 
+void DefaultDiskWriterTest::testWriteDataVector()
+{
+  std::string filename =
+      A2_TEST_OUT_DIR "/aria2_DefaultDiskWriterTest_testWriteDataVector";
+  DefaultDiskWriter dw(filename);
+  dw.initAndOpenFile();
+  std::string data1(300, '1'), data2(200, '2');
+  std::vector<DataSegment> segs;
+  for (int i = 0; i < 200; ++i) {
+    segs.push_back(DataSegment{
+        reinterpret_cast<const unsigned char*>(data1.c_str()), data1.size()});
+  }
+  segs.push_back(DataSegment{nullptr, 0});
+  segs.push_back(DataSegment{
+      reinterpret_cast<const unsigned char*>(data2.c_str()), data2.size()});
+  dw.writeDataVector(segs.data(), segs.size(), 7);
+  dw.closeFile();
+
+  std::string expected;
+  for (int i = 0; i < 200; ++i) {
+    expected += data1;
+  }
+  expected += data2;
+  auto content = readFile(filename);
+  CPPUNIT_ASSERT_EQUAL((size_t)7 + expected.size(), content.size());
+  CPPUNIT_ASSERT_EQUAL(expected, content.substr(7));
+}
+
+void DefaultDiskWriterTest::testWriteDataVector_overIovMax()
+{
+  std::string filename = A2_TEST_OUT_DIR
+      "/aria2_DefaultDiskWriterTest_testWriteDataVector_overIovMax";
+  DefaultDiskWriter dw(filename);
+  dw.initAndOpenFile();
+  // More segments than both A2_IOV_MAX and IOV_MAX (1024 on Linux),
+  // so that they are written by several pwritev() calls.  Some of
+  // them are empty.
+  size_t segcnt = std::max(A2_IOV_MAX, 1024) * 2 + 3;
+  std::vector<std::string> data;
+  for (size_t i = 0; i < segcnt; ++i) {
+    data.push_back(std::string(i % 7, 'a' + i % 26));
+  }
+  std::vector<DataSegment> segs;
+  std::string expected;
+  for (auto& d : data) {
+    segs.push_back(DataSegment{
+        reinterpret_cast<const unsigned char*>(d.c_str()), d.size()});
+    expected += d;
+  }
+  dw.writeDataVector(segs.data(), segs.size(), 3);
+  dw.closeFile();
+
+  auto content = readFile(filename);
+  CPPUNIT_ASSERT_EQUAL((size_t)3 + expected.size(), content.size());
+  CPPUNIT_ASSERT_EQUAL(expected, content.substr(3));
+}
+
 } // namespace aria2
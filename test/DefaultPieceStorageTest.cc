@@ -38,6 +38,9 @@ class DefaultPieceStorageTest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testMarkPiecesDone);
   CPPUNIT_TEST(testGetCompletedLength);
   CPPUNIT_TEST(testGetFilteredCompletedLength);
+  CPPUNIT_TEST(testGetInFlightPieces);
+  CPPUNIT_TEST(testGetPieceAvailability);
+  CPPUNIT_TEST(testGetSuperSeedingPiece);
   CPPUNIT_TEST(testGetNextUsedIndex);
   CPPUNIT_TEST(testAdvertisePiece);
   CPPUNIT_TEST_SUITE_END();
@@ -77,6 +80,9 @@ public:
   void testMarkPiecesDone();
   void testGetCompletedLength();
   void testGetFilteredCompletedLength();
+  void testGetInFlightPieces();
+  void testGetPieceAvailability();
+  void testGetSuperSeedingPiece();
   void testGetNextUsedIndex();
   void testAdvertisePiece();
 };
@@ -391,6 +397,76 @@ void DefaultPieceStorageTest::testGetFilteredCompletedLength()
                        ps.getFilteredCompletedLength());
 }
 
+void DefaultPieceStorageTest::testGetInFlightPieces()
+{
+  auto dctx = std::make_shared<DownloadContext>(1_m, 10_m);
+  DefaultPieceStorage ps(dctx, option_.get());
+  std::vector<std::shared_ptr<Piece>> inFlightPieces{
+      std::make_shared<Piece>(7, 1_m), std::make_shared<Piece>(2, 1_m),
+      std::make_shared<Piece>(5, 1_m)};
+  ps.addInFlightPiece(inFlightPieces);
+  CPPUNIT_ASSERT_EQUAL((size_t)3, ps.countInFlightPiece());
+  CPPUNIT_ASSERT(inFlightPieces[1] == ps.getPiece(2));
+
+  // Returned in the order of piece index
+  std::vector<std::shared_ptr<Piece>> pieces;
+  ps.getInFlightPieces(pieces);
+  CPPUNIT_ASSERT_EQUAL((size_t)3, pieces.size());
+  CPPUNIT_ASSERT_EQUAL((size_t)2, pieces[0]->getIndex());
+  CPPUNIT_ASSERT_EQUAL((size_t)5, pieces[1]->getIndex());
+  CPPUNIT_ASSERT_EQUAL((size_t)7, pieces[2]->getIndex());
+
+  ps.cancelPiece(inFlightPieces[2], 1);
+  CPPUNIT_ASSERT_EQUAL((size_t)2, ps.countInFlightPiece());
+  CPPUNIT_ASSERT(inFlightPieces[2] != ps.getPiece(5));
+}
+
+void DefaultPieceStorageTest::testGetPieceAvailability()
+{
+  DefaultPieceStorage ps(dctx_, option_.get());
+  unsigned char bitfield[] = {0x80};
+  ps.setBitfield(bitfield, sizeof(bitfield));
+  ps.completePiece(ps.getMissingPiece(1, 1));
+  // Our own pieces are not counted.
+  CPPUNIT_ASSERT_EQUAL((size_t)0, ps.getPieceAvailability(0));
+  CPPUNIT_ASSERT_EQUAL((size_t)0, ps.getPieceAvailability(1));
+  CPPUNIT_ASSERT_EQUAL((size_t)0, ps.getPieceAvailability(2));
+
+  ps.addPieceStats(0);
+  ps.addPieceStats(1);
+  CPPUNIT_ASSERT_EQUAL((size_t)1, ps.getPieceAvailability(0));
+  CPPUNIT_ASSERT_EQUAL((size_t)1, ps.getPieceAvailability(1));
+  CPPUNIT_ASSERT_EQUAL((size_t)0, ps.getPieceAvailability(2));
+}
+
+void DefaultPieceStorageTest::testGetSuperSeedingPiece()
+{
+  DefaultPieceStorage ps(dctx_, option_.get());
+  ps.markAllPiecesDone();
+  ps.addPieceStats(0);
+  ps.addPieceStats(0);
+  CPPUNIT_ASSERT_EQUAL((size_t)2, ps.getPieceAvailability(0));
+  CPPUNIT_ASSERT_EQUAL((size_t)0, ps.getPieceAvailability(1));
+
+  // Piece 1 and 2 are equally rare.  They are revealed in turn.
+  size_t first, second, index;
+  CPPUNIT_ASSERT(ps.getSuperSeedingPiece(first, peer));
+  CPPUNIT_ASSERT(first == 1 || first == 2);
+  CPPUNIT_ASSERT(ps.getSuperSeedingPiece(second, peer));
+  CPPUNIT_ASSERT_EQUAL((size_t)3, first + second);
+
+  // The pieces the peer has are never revealed.
+  peer->updateBitfield(1, 1);
+  peer->updateBitfield(2, 1);
+  ps.addPieceStats(1);
+  ps.addPieceStats(2);
+  CPPUNIT_ASSERT(ps.getSuperSeedingPiece(index, peer));
+  CPPUNIT_ASSERT_EQUAL((size_t)0, index);
+
+  peer->setAllBitfield();
+  CPPUNIT_ASSERT(!ps.getSuperSeedingPiece(index, peer));
+}
+
 void DefaultPieceStorageTest::testGetNextUsedIndex()
 {
   DefaultPieceStorage pss(dctx_, option_.get());
@@ -0,0 +1,178 @@
+#include "DownloadCommand.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "DownloadEngine.h"
+#include "SelectEventPoll.h"
+#include "RequestGroupMan.h"
+#include "RequestGroup.h"
+#include "DownloadContext.h"
+#include "FileEntry.h"
+#include "GroupId.h"
+#include "Option.h"
+#include "prefs.h"
+#include "Request.h"
+#include "SocketCore.h"
+#include "SocketRecvBuffer.h"
+#include "SegmentMan.h"
+#include "Segment.h"
+#include "Piece.h"
+#include "PieceStorage.h"
+#include "WrDiskCache.h"
+#include "WrDiskCacheEntry.h"
+#include "ByteArrayDiskWriterFactory.h"
+
+namespace aria2 {
+
+class DownloadCommandTest : public CppUnit::TestFixture {
+
+  CPPUNIT_TEST_SUITE(DownloadCommandTest);
+  CPPUNIT_TEST(testReceiveIntoWrDiskCache);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::unique_ptr<DownloadEngine> e_;
+  std::shared_ptr<Option> option_;
+  std::shared_ptr<RequestGroup> group_;
+  std::shared_ptr<SocketCore> writeSock_;
+  std::shared_ptr<SocketCore> readSock_;
+
+public:
+  void setUp()
+  {
+    option_ = std::make_shared<Option>();
+    option_->put(PREF_DISK_CACHE, "16777216");
+    e_ = make_unique<DownloadEngine>(make_unique<SelectEventPoll>());
+    e_->setOption(option_.get());
+    auto rgman = make_unique<RequestGroupMan>(
+        std::vector<std::shared_ptr<RequestGroup>>{}, 1, option_.get());
+    rgman->initWrDiskCache();
+
+    auto dctx = std::make_shared<DownloadContext>(
+        1_m, 1_m, A2_TEST_OUT_DIR "/aria2_DownloadCommandTest");
+    group_ = std::make_shared<RequestGroup>(GroupId::create(), option_);
+    group_->setDownloadContext(dctx);
+    group_->setRequestGroupMan(rgman.get());
+    group_->setDiskWriterFactory(
+        std::make_shared<ByteArrayDiskWriterFactory>());
+    group_->initPieceStorage();
+    e_->setRequestGroupMan(std::move(rgman));
+
+    SocketCore serverSock;
+    serverSock.bind(0);
+    serverSock.beginListen();
+    serverSock.setBlockingMode();
+    writeSock_ = std::make_shared<SocketCore>();
+    writeSock_->establishConnection("localhost",
+                                    serverSock.getAddrInfo().port);
+    writeSock_->setBlockingMode();
+    readSock_ = serverSock.acceptConnection();
+    readSock_->setNonBlockingMode();
+  }
+
+  void testReceiveIntoWrDiskCache();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(DownloadCommandTest);
+
+namespace {
+class TestDownloadCommand : public DownloadCommand {
+public:
+  TestDownloadCommand(const std::shared_ptr<Request>& req,
+                      RequestGroup* requestGroup, DownloadEngine* e,
+                      const std::shared_ptr<SocketCore>& s)
+      : DownloadCommand(1, req, requestGroup->getDownloadContext()
+                                    ->getFirstFileEntry(),
+                        requestGroup, e, s,
+                        std::make_shared<SocketRecvBuffer>(s))
+  {
+  }
+
+  virtual int64_t getRequestEndOffset() const CXX11_OVERRIDE
+  {
+    return getFileEntry()->getLength();
+  }
+};
+
+// Sends |len| bytes to |sock| and appends them to |sent|.
+void send(SocketCore& sock, size_t len, std::string& sent)
+{
+  std::string data;
+  for (size_t i = 0; i < len; ++i) {
+    data += static_cast<char>(sent.size() + i);
+  }
+  sock.writeData(data);
+  sent += data;
+}
+
+std::string getCachedData(const std::shared_ptr<Segment>& segment)
+{
+  std::string res;
+  auto& cells = segment->getPiece()->getWrDiskCacheEntry()->getDataSet();
+  for (auto cell : cells) {
+    auto first = cell->data + cell->offset;
+    res.append(first, first + cell->len);
+  }
+  return res;
+}
+} // namespace
+
+void DownloadCommandTest::testReceiveIntoWrDiskCache()
+{
+  auto req = std::make_shared<Request>();
+  req->setUri("http://localhost/aria2_DownloadCommandTest");
+  TestDownloadCommand command(req, group_.get(), e_.get(), readSock_);
+  auto segment = group_->getSegmentMan()->getSegmentWithIndex(1, 0);
+  auto& cells = segment->getPiece()->getWrDiskCacheEntry()->getDataSet();
+  auto wrDiskCache = group_->getPieceStorage()->getWrDiskCache();
+  std::string sent;
+
+  // Nothing to receive
+  CPPUNIT_ASSERT_EQUAL((size_t)0,
+                       command.receiveIntoWrDiskCache(segment, 1_m));
+
+  // The read size starts at 16KiB, and doubles if the whole buffer is
+  // filled.
+  send(*writeSock_, 88_k, sent);
+  CPPUNIT_ASSERT_EQUAL((size_t)16_k,
+                       command.receiveIntoWrDiskCache(segment, 1_m));
+  CPPUNIT_ASSERT_EQUAL((size_t)32_k,
+                       command.receiveIntoWrDiskCache(segment, 1_m));
+  // 40KiB fills more than a half of 64KiB buffer, so it is adopted
+  // as a cell.  The buffer is shrunk, so that the cell has no space
+  // which the disk cache does not count.
+  CPPUNIT_ASSERT_EQUAL((size_t)40_k,
+                       command.receiveIntoWrDiskCache(segment, 1_m));
+  CPPUNIT_ASSERT_EQUAL((size_t)3, cells.size());
+  for (auto cell : cells) {
+    CPPUNIT_ASSERT_EQUAL(cell->len, cell->capacity);
+  }
+  CPPUNIT_ASSERT_EQUAL((size_t)88_k, wrDiskCache->getSize());
+
+  // Less than a half of 64KiB.  The data goes through SinkStreamFilter,
+  // which allocates a cell of at least 4KiB, and the read size is
+  // halved.
+  send(*writeSock_, 1000, sent);
+  CPPUNIT_ASSERT_EQUAL((size_t)1000,
+                       command.receiveIntoWrDiskCache(segment, 1_m));
+  CPPUNIT_ASSERT_EQUAL((size_t)4, cells.size());
+  CPPUNIT_ASSERT_EQUAL((size_t)4_k, (*cells.rbegin())->capacity);
+  CPPUNIT_ASSERT_EQUAL((size_t)88_k + 1000, wrDiskCache->getSize());
+
+  send(*writeSock_, 64_k, sent);
+  CPPUNIT_ASSERT_EQUAL((size_t)32_k,
+                       command.receiveIntoWrDiskCache(segment, 1_m));
+  // |maxlen| limits the read size.
+  CPPUNIT_ASSERT_EQUAL((size_t)10000,
+                       command.receiveIntoWrDiskCache(segment, 10000));
+  CPPUNIT_ASSERT_EQUAL((size_t)6, cells.size());
+
+  CPPUNIT_ASSERT_EQUAL(sent.substr(0, segment->getWrittenLength()),
+                       getCachedData(segment));
+  CPPUNIT_ASSERT_EQUAL((int64_t)segment->getWrittenLength(),
+                       (int64_t)wrDiskCache->getSize());
+
+  segment->clear(wrDiskCache);
+}
+
+} // namespace aria2
@@ -143,6 +143,13 @@ void HandshakeExtensionMessageTest::testCreate()
   CPPUNIT_ASSERT_EQUAL(
       (uint8_t)1, m->getExtensionMessageID(ExtensionMessageRegistry::UT_PEX));
   CPPUNIT_ASSERT_EQUAL((size_t)1_k, m->getMetadataSize());
+  CPPUNIT_ASSERT_EQUAL((size_t)0, m->getReqq());
+  {
+    std::string in = "0d1:md6:ut_pexi1ee4:reqqi250ee";
+    auto m = HandshakeExtensionMessage::create(
+        reinterpret_cast<const unsigned char*>(in.c_str()), in.size());
+    CPPUNIT_ASSERT_EQUAL((size_t)250, m->getReqq());
+  }
   try {
     // bad payload format
     std::string in = "011:hello world";
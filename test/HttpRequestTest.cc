@@ -867,6 +867,18 @@ void HttpRequestTest::testEnableAcceptEncoding()
 #ifdef HAVE_ZLIB
   acceptEncodings += "deflate, gzip";
 #endif // HAVE_ZLIB
+#ifdef HAVE_LIBBROTLI
+  if (!acceptEncodings.empty()) {
+    acceptEncodings += ", ";
+  }
+  acceptEncodings += "br";
+#endif // HAVE_LIBBROTLI
+#ifdef HAVE_LIBZSTD
+  if (!acceptEncodings.empty()) {
+    acceptEncodings += ", ";
+  }
+  acceptEncodings += "zstd";
+#endif // HAVE_LIBZSTD
 
   std::string expectedTextHead =
       "GET /archives/aria2-1.0.0.tar.bz2 HTTP/1.1\r\n"
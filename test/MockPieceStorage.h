@@ -94,6 +94,15 @@ public:
     return std::shared_ptr<Piece>(new Piece());
   }
 
+  virtual bool
+  getSuperSeedingPiece(size_t& index,
+                       const std::shared_ptr<Peer>& peer) CXX11_OVERRIDE
+  {
+    return false;
+  }
+
+  virtual SmartBan* getSmartBan() CXX11_OVERRIDE { return nullptr; }
+
 #endif // ENABLE_BITTORRENT
 
   virtual bool hasMissingUnusedPiece() CXX11_OVERRIDE { return false; }
@@ -228,6 +237,8 @@ public:
 
   virtual WrDiskCache* getWrDiskCache() CXX11_OVERRIDE { return 0; }
 
+  virtual RdDiskCache* getRdDiskCache() CXX11_OVERRIDE { return 0; }
+
   virtual void flushWrDiskCacheEntry(bool releaseEntries) CXX11_OVERRIDE {}
 
   void setDiskAdaptor(const std::shared_ptr<DiskAdaptor>& adaptor)
@@ -277,6 +288,11 @@ public:
 
   virtual void addPieceStats(size_t index) CXX11_OVERRIDE {}
 
+  virtual size_t getPieceAvailability(size_t index) CXX11_OVERRIDE
+  {
+    return 0;
+  }
+
   virtual void addPieceStats(const unsigned char* bitfield,
                              size_t bitfieldLength) CXX11_OVERRIDE
   {
@@ -11,6 +11,7 @@ class PieceStatManTest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testAddPieceStats_bitfield);
   CPPUNIT_TEST(testUpdatePieceStats);
   CPPUNIT_TEST(testSubtractPieceStats);
+  CPPUNIT_TEST(testGetRarestOrder);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -22,6 +23,7 @@ public:
   void testAddPieceStats_bitfield();
   void testUpdatePieceStats();
   void testSubtractPieceStats();
+  void testGetRarestOrder();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(PieceStatManTest);
@@ -126,4 +128,38 @@ void PieceStatManTest::testSubtractPieceStats()
   }
 }
 
+void PieceStatManTest::testGetRarestOrder()
+{
+  PieceStatMan pieceStatMan(10, false);
+  const unsigned char bitfield[] = {0xf0, 0xc0};
+  pieceStatMan.addPieceStats(bitfield, sizeof(bitfield));
+  pieceStatMan.addPieceStats(1);
+  pieceStatMan.addPieceStats(9);
+  pieceStatMan.addPieceStats(9);
+  const unsigned char oldBitfield[] = {0xf0, 0x00};
+  const unsigned char newBitfield[] = {0x1f, 0x00};
+  pieceStatMan.updatePieceStats(newBitfield, sizeof(newBitfield), oldBitfield);
+  pieceStatMan.subtractPieceStats(bitfield, sizeof(bitfield));
+  // idx: 0, 1, 2, 3, 4, 5, 6, 7, 8, 9
+  // res: 0, 0, 0, 0, 1, 1, 1, 1, 0, 2
+  int ans[] = {0, 0, 0, 0, 1, 1, 1, 1, 0, 2};
+  const std::vector<int>& counts(pieceStatMan.getCounts());
+  for (size_t i = 0; i < 10; ++i) {
+    CPPUNIT_ASSERT_EQUAL(ans[i], counts[i]);
+  }
+  const std::vector<size_t>& order(pieceStatMan.getRarestOrder());
+  CPPUNIT_ASSERT_EQUAL((size_t)10, order.size());
+  std::vector<int> seen(10);
+  for (size_t i = 0; i < 10; ++i) {
+    ++seen[order[i]];
+    if (i > 0) {
+      CPPUNIT_ASSERT(counts[order[i - 1]] <= counts[order[i]]);
+    }
+  }
+  for (size_t i = 0; i < 10; ++i) {
+    CPPUNIT_ASSERT_EQUAL(1, seen[i]);
+  }
+  CPPUNIT_ASSERT_EQUAL((size_t)9, order[9]);
+}
+
 } // namespace aria2
@@ -0,0 +1,136 @@
+#include "RdDiskCache.h"
+
+#include <cstring>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "TestUtil.h"
+#include "DirectDiskAdaptor.h"
+#include "ByteArrayDiskWriter.h"
+
+namespace aria2 {
+
+class RdDiskCacheTest : public CppUnit::TestFixture {
+
+  CPPUNIT_TEST_SUITE(RdDiskCacheTest);
+  CPPUNIT_TEST(testReadData);
+  CPPUNIT_TEST(testReadData_evict);
+  CPPUNIT_TEST(testRemove);
+  CPPUNIT_TEST(testReadAhead);
+  CPPUNIT_TEST_SUITE_END();
+
+  std::shared_ptr<DirectDiskAdaptor> adaptor_;
+  ByteArrayDiskWriter* writer_;
+
+public:
+  void setUp()
+  {
+    adaptor_ = std::make_shared<DirectDiskAdaptor>();
+    auto dw = make_unique<ByteArrayDiskWriter>();
+    writer_ = dw.get();
+    adaptor_->setDiskWriter(std::move(dw));
+    writer_->setString("0123456789abcdefghij");
+  }
+
+  void testReadData();
+  void testReadData_evict();
+  void testRemove();
+  void testReadAhead();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(RdDiskCacheTest);
+
+void RdDiskCacheTest::testReadData()
+{
+  RdDiskCache dc(20);
+  unsigned char buf[10];
+  CPPUNIT_ASSERT_EQUAL((ssize_t)3,
+                       dc.readData(adaptor_, 1, 10, 10, buf, 3, 12));
+  CPPUNIT_ASSERT_EQUAL(std::string("cde"), std::string(&buf[0], &buf[3]));
+  CPPUNIT_ASSERT_EQUAL((size_t)10, dc.getSize());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, dc.getMisses());
+
+  // Served from the cache even if the data on disk has changed.
+  writer_->setString("0123456789ABCDEFGHIJ");
+  CPPUNIT_ASSERT_EQUAL((ssize_t)4,
+                       dc.readData(adaptor_, 1, 10, 10, buf, 4, 16));
+  CPPUNIT_ASSERT_EQUAL(std::string("ghij"), std::string(&buf[0], &buf[4]));
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, dc.getHits());
+
+  // Piece larger than the cache is read directly.
+  RdDiskCache small(5);
+  CPPUNIT_ASSERT_EQUAL((ssize_t)2,
+                       small.readData(adaptor_, 0, 0, 10, buf, 2, 0));
+  CPPUNIT_ASSERT_EQUAL(std::string("01"), std::string(&buf[0], &buf[2]));
+  CPPUNIT_ASSERT_EQUAL((size_t)0, small.getSize());
+}
+
+void RdDiskCacheTest::testReadData_evict()
+{
+  RdDiskCache dc(15);
+  unsigned char buf[10];
+  dc.readData(adaptor_, 0, 0, 5, buf, 1, 0);
+  dc.readData(adaptor_, 1, 5, 5, buf, 1, 5);
+  dc.readData(adaptor_, 2, 10, 5, buf, 1, 10);
+  CPPUNIT_ASSERT_EQUAL((size_t)15, dc.getSize());
+  // Touch piece 0 so that piece 1 becomes the least recently used.
+  dc.readData(adaptor_, 0, 0, 5, buf, 1, 0);
+  dc.readData(adaptor_, 3, 15, 5, buf, 1, 15);
+  CPPUNIT_ASSERT_EQUAL((size_t)15, dc.getSize());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, dc.getEvictions());
+
+  dc.readData(adaptor_, 0, 0, 5, buf, 1, 0);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)2, dc.getHits());
+  dc.readData(adaptor_, 1, 5, 5, buf, 1, 5);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)5, dc.getMisses());
+}
+
+void RdDiskCacheTest::testRemove()
+{
+  RdDiskCache dc(20);
+  unsigned char buf[10];
+  dc.readData(adaptor_, 0, 0, 10, buf, 1, 0);
+  CPPUNIT_ASSERT_EQUAL((size_t)10, dc.getSize());
+  dc.remove(adaptor_, 1);
+  CPPUNIT_ASSERT_EQUAL((size_t)10, dc.getSize());
+  dc.remove(adaptor_, 0);
+  CPPUNIT_ASSERT_EQUAL((size_t)0, dc.getSize());
+
+  writer_->setString("ABCDEFGHIJ");
+  dc.readData(adaptor_, 0, 0, 10, buf, 3, 0);
+  CPPUNIT_ASSERT_EQUAL(std::string("ABC"), std::string(&buf[0], &buf[3]));
+}
+
+void RdDiskCacheTest::testReadAhead()
+{
+  RdDiskCache dc(20);
+  unsigned char buf[10];
+  dc.readData(adaptor_, 1, 5, 5, buf, 5, 5);
+  // Piece 0 is not cached, so the access does not look sequential.
+  dc.readAhead(adaptor_, 2, 10, 5);
+  CPPUNIT_ASSERT_EQUAL((size_t)5, dc.getSize());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0, dc.getReadAheads());
+
+  dc.readData(adaptor_, 0, 0, 5, buf, 5, 0);
+  dc.readAhead(adaptor_, 2, 10, 5);
+  CPPUNIT_ASSERT_EQUAL((size_t)15, dc.getSize());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, dc.getReadAheads());
+  // Already cached
+  dc.readAhead(adaptor_, 2, 10, 5);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, dc.getReadAheads());
+
+  CPPUNIT_ASSERT_EQUAL((ssize_t)5,
+                       dc.readData(adaptor_, 2, 10, 5, buf, 5, 10));
+  CPPUNIT_ASSERT_EQUAL(std::string("abcde"), std::string(&buf[0], &buf[5]));
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, dc.getHits());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)2, dc.getMisses());
+
+  // Piece larger than a half of the cache is not read ahead.
+  RdDiskCache small(19);
+  small.readData(adaptor_, 0, 0, 5, buf, 1, 0);
+  small.readData(adaptor_, 1, 5, 5, buf, 1, 5);
+  small.readAhead(adaptor_, 2, 10, 10);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0, small.getReadAheads());
+}
+
+} // namespace aria2
@@ -20,6 +20,7 @@
 #include "DownloadEngine.h"
 #include "SelectEventPoll.h"
 #include "UriListParser.h"
+#include "RdDiskCache.h"
 
 namespace aria2 {
 
@@ -35,6 +36,7 @@ class RequestGroupManTest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testFillRequestGroupFromReserver_uriParser);
   CPPUNIT_TEST(testInsertReservedGroup);
   CPPUNIT_TEST(testAddDownloadResult);
+  CPPUNIT_TEST(testInitRdDiskCache);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -67,6 +69,7 @@ public:
   void testFillRequestGroupFromReserver_uriParser();
   void testInsertReservedGroup();
   void testAddDownloadResult();
+  void testInitRdDiskCache();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(RequestGroupManTest);
@@ -280,4 +283,17 @@ void RequestGroupManTest::testAddDownloadResult()
                        rgman_->getDownloadStat().getLastErrorResult());
 }
 
+void RequestGroupManTest::testInitRdDiskCache()
+{
+  option_->put(PREF_DISK_READ_CACHE, "0");
+  rgman_->initRdDiskCache();
+  CPPUNIT_ASSERT(!rgman_->getRdDiskCache());
+
+  // 4GiB does not fit in int, nor in 32-bit size_t.
+  option_->put(PREF_DISK_READ_CACHE, "4294967296");
+  rgman_->initRdDiskCache();
+  CPPUNIT_ASSERT(rgman_->getRdDiskCache());
+  CPPUNIT_ASSERT_EQUAL((int64_t)4_g, rgman_->getRdDiskCache()->getLimit());
+}
+
 } // namespace aria2
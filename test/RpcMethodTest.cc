@@ -21,10 +21,15 @@
 #include "download_helper.h"
 #include "FileEntry.h"
 #include "RpcMethodFactory.h"
+#include "RdDiskCache.h"
+#include "DirectDiskAdaptor.h"
+#include "ByteArrayDiskWriter.h"
 #ifdef ENABLE_BITTORRENT
 #  include "BtRegistry.h"
 #  include "BtRuntime.h"
 #  include "bittorrent_helper.h"
+#  include "DefaultPeerStorage.h"
+#  include "Peer.h"
 #endif // ENABLE_BITTORRENT
 
 namespace aria2 {
@@ -65,6 +70,7 @@ class RpcMethodTest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testTellWaiting);
   CPPUNIT_TEST(testTellWaiting_fail);
   CPPUNIT_TEST(testGetVersion);
+  CPPUNIT_TEST(testGetGlobalStat);
   CPPUNIT_TEST(testNoSuchMethod);
   CPPUNIT_TEST(testGatherStoppedDownload);
 #ifdef ENABLE_BITTORRENT
@@ -73,6 +79,7 @@ class RpcMethodTest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testGatherProgressCommon);
 #ifdef ENABLE_BITTORRENT
   CPPUNIT_TEST(testGatherBitTorrentMetadata);
+  CPPUNIT_TEST(testGetPeers);
 #endif // ENABLE_BITTORRENT
   CPPUNIT_TEST(testChangePosition);
   CPPUNIT_TEST(testChangePosition_fail);
@@ -135,6 +142,7 @@ public:
   void testTellWaiting();
   void testTellWaiting_fail();
   void testGetVersion();
+  void testGetGlobalStat();
   void testNoSuchMethod();
   void testGatherStoppedDownload();
 #ifdef ENABLE_BITTORRENT
@@ -143,6 +151,7 @@ public:
   void testGatherProgressCommon();
 #ifdef ENABLE_BITTORRENT
   void testGatherBitTorrentMetadata();
+  void testGetPeers();
 #endif // ENABLE_BITTORRENT
   void testChangePosition();
   void testChangePosition_fail();
@@ -920,6 +929,42 @@ void RpcMethodTest::testGetVersion()
   CPPUNIT_ASSERT_EQUAL(featureSummary() + ", ", features);
 }
 
+void RpcMethodTest::testGetGlobalStat()
+{
+  GetGlobalStatRpcMethod m;
+  auto res =
+      m.execute(createReq(GetGlobalStatRpcMethod::getMethodName()), e_.get());
+  CPPUNIT_ASSERT_EQUAL(0, res.code);
+  const Dict* resParams = downcast<Dict>(res.param);
+  CPPUNIT_ASSERT_EQUAL(std::string("0"), getString(resParams, "numActive"));
+  CPPUNIT_ASSERT(!resParams->containsKey("diskReadCacheHits"));
+
+  option_->put(PREF_DISK_READ_CACHE, "1024");
+  e_->getRequestGroupMan()->initRdDiskCache();
+  auto adaptor = std::make_shared<DirectDiskAdaptor>();
+  auto dw = make_unique<ByteArrayDiskWriter>();
+  dw->setString("0123456789");
+  adaptor->setDiskWriter(std::move(dw));
+  auto rdDiskCache = e_->getRequestGroupMan()->getRdDiskCache();
+  unsigned char buf[10];
+  // 1 miss and 3 hits
+  for (int i = 0; i < 4; ++i) {
+    rdDiskCache->readData(adaptor, 0, 0, 10, buf, 1, i);
+  }
+  res =
+      m.execute(createReq(GetGlobalStatRpcMethod::getMethodName()), e_.get());
+  CPPUNIT_ASSERT_EQUAL(0, res.code);
+  resParams = downcast<Dict>(res.param);
+  CPPUNIT_ASSERT_EQUAL(std::string("3"),
+                       getString(resParams, "diskReadCacheHits"));
+  CPPUNIT_ASSERT_EQUAL(std::string("1"),
+                       getString(resParams, "diskReadCacheMisses"));
+  CPPUNIT_ASSERT_EQUAL(std::string("75"),
+                       getString(resParams, "diskReadCacheHitRatio"));
+  CPPUNIT_ASSERT_EQUAL(std::string("0"),
+                       getString(resParams, "diskReadCacheEvictions"));
+}
+
 void RpcMethodTest::testGatherStoppedDownload()
 {
   std::vector<std::shared_ptr<FileEntry>> fileEntries;
@@ -1078,6 +1123,34 @@ void RpcMethodTest::testGatherBitTorrentMetadata()
   CPPUNIT_ASSERT(!btDict->containsKey("info"));
   CPPUNIT_ASSERT(btDict->containsKey("announceList"));
 }
+
+void RpcMethodTest::testGetPeers()
+{
+  auto group = std::make_shared<RequestGroup>(GroupId::create(), option_);
+  e_->getRequestGroupMan()->addReservedGroup(group);
+  auto peerStorage = std::make_shared<DefaultPeerStorage>();
+  auto peer = std::make_shared<Peer>("192.168.0.1", 6881);
+  peerStorage->addAndCheckoutPeer(peer, 1);
+  peer->allocateSessionResource(1_m, 10_m);
+  peer->setMaxOutstandingRequest(42);
+  {
+    auto btObject = make_unique<BtObject>();
+    btObject->peerStorage = peerStorage;
+    e_->getBtRegistry()->put(group->getGID(), std::move(btObject));
+  }
+
+  GetPeersRpcMethod m;
+  auto req = createReq(GetPeersRpcMethod::getMethodName());
+  req.params->append(GroupId::toHex(group->getGID()));
+  auto res = m.execute(std::move(req), e_.get());
+  CPPUNIT_ASSERT_EQUAL(0, res.code);
+  const List* peers = downcast<List>(res.param);
+  CPPUNIT_ASSERT_EQUAL((size_t)1, peers->size());
+  const Dict* peerEntry = downcast<Dict>(peers->get(0));
+  CPPUNIT_ASSERT_EQUAL(std::string("192.168.0.1"), getString(peerEntry, "ip"));
+  CPPUNIT_ASSERT_EQUAL(std::string("42"),
+                       getString(peerEntry, "requestQueueDepth"));
+}
 #endif // ENABLE_BITTORRENT
 
 void RpcMethodTest::testChangePosition()
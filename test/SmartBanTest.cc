@@ -0,0 +1,82 @@
+#include "SmartBan.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Piece.h"
+
+namespace aria2 {
+
+class SmartBanTest : public CppUnit::TestFixture {
+
+  CPPUNIT_TEST_SUITE(SmartBanTest);
+  CPPUNIT_TEST(testFindCorruptPeers);
+  CPPUNIT_TEST(testAddFailedPiece_unknownContributor);
+  CPPUNIT_TEST(testAvoidPeer);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void testFindCorruptPeers();
+  void testAddFailedPiece_unknownContributor();
+  void testAvoidPeer();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SmartBanTest);
+
+void SmartBanTest::testFindCorruptPeers()
+{
+  // 3 blocks: 16KiB, 16KiB and 4KiB
+  Piece piece(1, 36_k, 16_k);
+  piece.setBlockContributor(0, "192.168.0.1");
+  piece.setBlockContributor(1, "192.168.0.2");
+  piece.setBlockContributor(2, "192.168.0.2");
+
+  SmartBan smartBan;
+  smartBan.addFailedPiece(piece, {"a", "b", "c"});
+  // Same data from the same peers must not be recorded twice.
+  smartBan.addFailedPiece(piece, {"a", "b", "c"});
+  CPPUNIT_ASSERT(smartBan.hasRecord(1));
+  CPPUNIT_ASSERT(!smartBan.hasRecord(0));
+  CPPUNIT_ASSERT_EQUAL((size_t)1, smartBan.countRecord());
+
+  auto res = smartBan.findCorruptPeers(1, {"a", "B", "C"});
+  CPPUNIT_ASSERT_EQUAL((size_t)1, res.size());
+  CPPUNIT_ASSERT_EQUAL((int64_t)20_k, res["192.168.0.2"]);
+  CPPUNIT_ASSERT(!smartBan.hasRecord(1));
+  CPPUNIT_ASSERT(smartBan.findCorruptPeers(1, {"a", "B", "C"}).empty());
+}
+
+void SmartBanTest::testAddFailedPiece_unknownContributor()
+{
+  Piece piece(0, 32_k, 16_k);
+  SmartBan smartBan;
+  smartBan.addFailedPiece(piece, {"a", "b"});
+  CPPUNIT_ASSERT(!smartBan.hasRecord(0));
+  CPPUNIT_ASSERT_EQUAL((size_t)0, smartBan.countRecord());
+}
+
+void SmartBanTest::testAvoidPeer()
+{
+  Piece piece(1, 32_k, 16_k);
+  piece.setBlockContributor(0, "192.168.0.1");
+  piece.setBlockContributor(1, "192.168.0.2");
+
+  SmartBan smartBan;
+  smartBan.addFailedPiece(piece, {"a", "b"});
+
+  CPPUNIT_ASSERT(smartBan.findFailedPieces("192.168.0.1") ==
+                 std::vector<size_t>{1});
+  CPPUNIT_ASSERT(smartBan.findFailedPieces("192.168.0.3").empty());
+
+  // Only the peers which sent the blocks have the piece.
+  CPPUNIT_ASSERT(!smartBan.avoidPeer(1, "192.168.0.1", 2));
+  // Another peer has the piece.
+  CPPUNIT_ASSERT(smartBan.avoidPeer(1, "192.168.0.1", 3));
+  CPPUNIT_ASSERT(smartBan.avoidPeer(1, "192.168.0.2", 3));
+  CPPUNIT_ASSERT(!smartBan.avoidPeer(1, "192.168.0.3", 3));
+  CPPUNIT_ASSERT(!smartBan.avoidPeer(0, "192.168.0.1", 3));
+
+  smartBan.findCorruptPeers(1, {"a", "b"});
+  CPPUNIT_ASSERT(!smartBan.avoidPeer(1, "192.168.0.1", 3));
+}
+
+} // namespace aria2
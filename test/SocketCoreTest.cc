@@ -6,6 +6,10 @@
 
 #include "a2functional.h"
 #include "Exception.h"
+#ifdef ENABLE_SSL
+#  include "TLSContext.h"
+#  include "TLSSessionCache.h"
+#endif // ENABLE_SSL
 
 namespace aria2 {
 
@@ -18,12 +22,22 @@ class SocketCoreTest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testInetPton);
   CPPUNIT_TEST(testGetBinAddr);
   CPPUNIT_TEST(testVerifyHostname);
+#ifdef HAVE_OPENSSL
+  CPPUNIT_TEST(testTLSSessionCache);
+  CPPUNIT_TEST(testTLSSessionCache_handshakeFailure);
+#endif // HAVE_OPENSSL
   CPPUNIT_TEST_SUITE_END();
 
 public:
   void setUp() {}
 
-  void tearDown() {}
+  void tearDown()
+  {
+#ifdef ENABLE_SSL
+    SocketCore::setClientTLSContext(nullptr);
+    SocketCore::setServerTLSContext(nullptr);
+#endif // ENABLE_SSL
+  }
 
   void testWriteAndReadDatagram();
   void testGetSocketError();
@@ -31,6 +45,10 @@ public:
   void testInetPton();
   void testGetBinAddr();
   void testVerifyHostname();
+#ifdef HAVE_OPENSSL
+  void testTLSSessionCache();
+  void testTLSSessionCache_handshakeFailure();
+#endif // HAVE_OPENSSL
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(SocketCoreTest);
@@ -239,4 +257,114 @@ void SocketCoreTest::testVerifyHostname()
   }
 }
 
+#ifdef HAVE_OPENSSL
+namespace {
+std::shared_ptr<TLSSessionCache> setUpTLSContexts()
+{
+  std::shared_ptr<TLSContext> svTlsContext(
+      TLSContext::make(TLS_SERVER, TLS_PROTO_TLS12));
+  CPPUNIT_ASSERT(svTlsContext->addCredentialFile(
+      A2_TEST_DIR "/tls-server.crt", A2_TEST_DIR "/tls-server.key"));
+  SocketCore::setServerTLSContext(svTlsContext);
+
+  std::shared_ptr<TLSContext> clTlsContext(
+      TLSContext::make(TLS_CLIENT, TLS_PROTO_TLS12));
+  clTlsContext->setVerifyPeer(false);
+  auto sessionCache = std::make_shared<TLSSessionCache>();
+  SocketCore::setClientTLSContext(clTlsContext, sessionCache);
+  return sessionCache;
+}
+
+std::pair<std::shared_ptr<SocketCore>, std::shared_ptr<SocketCore>>
+connect(SocketCore& serverSock)
+{
+  auto clientSock = std::make_shared<SocketCore>();
+  clientSock->establishConnection("localhost", serverSock.getAddrInfo().port);
+  while (!clientSock->isWritable(0))
+    ;
+  auto sock = serverSock.acceptConnection();
+  sock->setNonBlockingMode();
+  return std::make_pair(clientSock, sock);
+}
+
+// Connects to |serverSock| as if the origin server were
+// localhost:443, receives one message and closes the connection.
+void fetch(SocketCore& serverSock)
+{
+  auto socks = connect(serverSock);
+  auto& clientSock = socks.first;
+  auto& sock = socks.second;
+  bool connected = false, accepted = false;
+  while (!connected || !accepted) {
+    if (!connected) {
+      connected = clientSock->tlsConnect("localhost", 443);
+    }
+    if (!accepted) {
+      accepted = sock->tlsAccept();
+    }
+  }
+  // With TLS 1.3, the session ticket is received along with the
+  // message.
+  sock->writeData("hello");
+  char buf[16];
+  size_t len = 0;
+  while (len == 0) {
+    len = sizeof(buf);
+    clientSock->readData(buf, len);
+  }
+  CPPUNIT_ASSERT_EQUAL(std::string("hello"), std::string(buf, len));
+  clientSock->closeConnection();
+}
+} // namespace
+
+void SocketCoreTest::testTLSSessionCache()
+{
+  auto sessionCache = setUpTLSContexts();
+  SocketCore serverSock;
+  serverSock.bind(0);
+  serverSock.beginListen();
+  serverSock.setBlockingMode();
+
+  fetch(serverSock);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0, sessionCache->getHits());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, sessionCache->getMisses());
+  CPPUNIT_ASSERT_EQUAL((size_t)1, sessionCache->size());
+
+  fetch(serverSock);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, sessionCache->getHits());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, sessionCache->getMisses());
+  CPPUNIT_ASSERT_EQUAL((size_t)1, sessionCache->size());
+  // The session is stored under the origin port, not the port we
+  // actually connected to.
+  CPPUNIT_ASSERT(!sessionCache->get("localhost:443").empty());
+}
+
+void SocketCoreTest::testTLSSessionCache_handshakeFailure()
+{
+  auto sessionCache = setUpTLSContexts();
+  SocketCore serverSock;
+  serverSock.bind(0);
+  serverSock.beginListen();
+  serverSock.setBlockingMode();
+
+  fetch(serverSock);
+  CPPUNIT_ASSERT_EQUAL((size_t)1, sessionCache->size());
+
+  // The server does not speak TLS. The cached session is offered and
+  // then dropped.
+  auto socks = connect(serverSock);
+  socks.second->writeData("HTTP/1.1 400 Bad Request\r\n\r\n");
+  try {
+    while (!socks.first->tlsConnect("localhost", 443))
+      ;
+    CPPUNIT_FAIL("exception must be thrown.");
+  }
+  catch (Exception& e) {
+    // success
+  }
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, sessionCache->getHits());
+  CPPUNIT_ASSERT_EQUAL((size_t)0, sessionCache->size());
+}
+#endif // HAVE_OPENSSL
+
 } // namespace aria2
@@ -0,0 +1,87 @@
+#include "SocketRecvBuffer.h"
+
+#include <cstring>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "SocketCore.h"
+
+namespace aria2 {
+
+class SocketRecvBufferTest : public CppUnit::TestFixture {
+
+  CPPUNIT_TEST_SUITE(SocketRecvBufferTest);
+  CPPUNIT_TEST(testRecv_adjustCapacity);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::shared_ptr<SocketCore> serverSocket_;
+  std::shared_ptr<SocketCore> clientSocket_;
+
+public:
+  void setUp()
+  {
+    std::shared_ptr<SocketCore> listenSocket(new SocketCore());
+    listenSocket->bind(0);
+    listenSocket->beginListen();
+    listenSocket->setBlockingMode();
+    uint16_t listenPort = listenSocket->getAddrInfo().port;
+
+    clientSocket_.reset(new SocketCore());
+    clientSocket_->establishConnection("localhost", listenPort);
+
+    while (!clientSocket_->isWritable(0))
+      ;
+
+    serverSocket_ = listenSocket->acceptConnection();
+    serverSocket_->setBlockingMode();
+  }
+
+  void testRecv_adjustCapacity();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SocketRecvBufferTest);
+
+void SocketRecvBufferTest::testRecv_adjustCapacity()
+{
+  SocketRecvBuffer buf(clientSocket_);
+  // Buffer is not allocated until the first recv()
+  CPPUNIT_ASSERT_EQUAL((size_t)0, buf.getCapacity());
+
+  std::string data(48_k, 'a');
+  serverSocket_->writeData(data.data(), data.size());
+  while (!clientSocket_->isReadable(0))
+    ;
+  CPPUNIT_ASSERT_EQUAL((ssize_t)16_k, buf.recv());
+  CPPUNIT_ASSERT_EQUAL((size_t)16_k, buf.getCapacity());
+  // Buffer is full, and capacity does not change until it is empty.
+  CPPUNIT_ASSERT_EQUAL((ssize_t)0, buf.recv());
+  buf.drain(10_k);
+  CPPUNIT_ASSERT_EQUAL((size_t)6_k, buf.getBufferLength());
+  buf.drain(6_k);
+  // The last recv() filled the buffer, so capacity grows.
+  CPPUNIT_ASSERT_EQUAL((ssize_t)32_k, buf.recv());
+  CPPUNIT_ASSERT_EQUAL((size_t)32_k, buf.getCapacity());
+  CPPUNIT_ASSERT(memcmp(data.data(), buf.getBuffer(), 32_k) == 0);
+  buf.drain(32_k);
+
+  serverSocket_->writeData("hello", 5);
+  while (!clientSocket_->isReadable(0))
+    ;
+  CPPUNIT_ASSERT_EQUAL((ssize_t)5, buf.recv());
+  CPPUNIT_ASSERT_EQUAL((size_t)64_k, buf.getCapacity());
+  CPPUNIT_ASSERT_EQUAL(std::string("hello"),
+                       std::string(buf.getBuffer(), buf.getBuffer() + 5));
+  buf.drain(5);
+
+  // The last recv() used little of the buffer, so capacity shrinks.
+  serverSocket_->writeData("world", 5);
+  while (!clientSocket_->isReadable(0))
+    ;
+  CPPUNIT_ASSERT_EQUAL((ssize_t)5, buf.recv());
+  CPPUNIT_ASSERT_EQUAL((size_t)32_k, buf.getCapacity());
+  CPPUNIT_ASSERT_EQUAL(std::string("world"),
+                       std::string(buf.getBuffer(), buf.getBuffer() + 5));
+}
+
+} // namespace aria2
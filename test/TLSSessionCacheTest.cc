@@ -0,0 +1,63 @@
+#include "TLSSessionCache.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace aria2 {
+
+class TLSSessionCacheTest : public CppUnit::TestFixture {
+
+  CPPUNIT_TEST_SUITE(TLSSessionCacheTest);
+  CPPUNIT_TEST(testGet);
+  CPPUNIT_TEST(testPut_evict);
+  CPPUNIT_TEST(testRemove);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void testGet();
+  void testPut_evict();
+  void testRemove();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TLSSessionCacheTest);
+
+void TLSSessionCacheTest::testGet()
+{
+  TLSSessionCache cache;
+  CPPUNIT_ASSERT_EQUAL(std::string(), cache.get("example.org:443"));
+  cache.put("example.org:443", "alpha");
+  // empty data is not stored
+  cache.put("example.org:8443", "");
+  CPPUNIT_ASSERT_EQUAL((size_t)1, cache.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("alpha"), cache.get("example.org:443"));
+  CPPUNIT_ASSERT_EQUAL(std::string(), cache.get("example.org:8443"));
+  cache.put("example.org:443", "bravo");
+  CPPUNIT_ASSERT_EQUAL(std::string("bravo"), cache.get("example.org:443"));
+  CPPUNIT_ASSERT_EQUAL((uint64_t)2, cache.getHits());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)2, cache.getMisses());
+}
+
+void TLSSessionCacheTest::testPut_evict()
+{
+  TLSSessionCache cache(2);
+  cache.put("a:443", "alpha");
+  cache.put("b:443", "bravo");
+  // Makes "a:443" most recently used
+  cache.get("a:443");
+  cache.put("c:443", "charlie");
+  CPPUNIT_ASSERT_EQUAL((size_t)2, cache.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("alpha"), cache.get("a:443"));
+  CPPUNIT_ASSERT_EQUAL(std::string(), cache.get("b:443"));
+  CPPUNIT_ASSERT_EQUAL(std::string("charlie"), cache.get("c:443"));
+}
+
+void TLSSessionCacheTest::testRemove()
+{
+  TLSSessionCache cache;
+  cache.put("a:443", "alpha");
+  cache.remove("a:443");
+  cache.remove("b:443");
+  CPPUNIT_ASSERT_EQUAL((size_t)0, cache.size());
+  CPPUNIT_ASSERT_EQUAL(std::string(), cache.get("a:443"));
+}
+
+} // namespace aria2
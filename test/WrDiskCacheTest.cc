@@ -40,6 +40,7 @@ void WrDiskCacheTest::testAdd()
   WrDiskCacheEntry e1(adaptor_);
   e1.cacheData(createDataCell(0, "who knows?"));
   CPPUNIT_ASSERT(dc.add(&e1));
+  CPPUNIT_ASSERT(!dc.add(&e1));
   CPPUNIT_ASSERT_EQUAL((size_t)10, dc.getSize());
 
   WrDiskCacheEntry e2(adaptor_);
@@ -58,20 +59,32 @@ void WrDiskCacheTest::testAdd()
   e3.cacheData(createDataCell(15, " world"));
   CPPUNIT_ASSERT(dc.update(&e3, 6));
 
-  // e3 is flushed to the disk
-  CPPUNIT_ASSERT_EQUAL(std::string("who knows?hello world"),
+  // e2 is the least recently updated entry and flushed to the disk
+  CPPUNIT_ASSERT_EQUAL(std::string("who knows?") + std::string(11, '\0') +
+                           "seconddata",
                        writer_->getString());
-  CPPUNIT_ASSERT_EQUAL((size_t)0, e3.getSize());
-  CPPUNIT_ASSERT_EQUAL((size_t)10, dc.getSize());
+  CPPUNIT_ASSERT_EQUAL((size_t)0, e2.getSize());
+  CPPUNIT_ASSERT_EQUAL((size_t)11, dc.getSize());
 
   e2.cacheData(createDataCell(31, "01234567890"));
   CPPUNIT_ASSERT(dc.update(&e2, 11));
-  // e2 is flushed to the disk
+  // e1 is empty, so e3 is flushed to the disk
+  CPPUNIT_ASSERT_EQUAL(std::string("who knows?hello worldseconddata"),
+                       writer_->getString());
+  CPPUNIT_ASSERT_EQUAL((size_t)0, e3.getSize());
+  CPPUNIT_ASSERT_EQUAL((size_t)11, dc.getSize());
+
+  CPPUNIT_ASSERT(dc.remove(&e2));
+  CPPUNIT_ASSERT(!dc.remove(&e2));
+  CPPUNIT_ASSERT(!dc.update(&e2, 0));
+  CPPUNIT_ASSERT_EQUAL((size_t)0, dc.getSize());
+  e2.writeToDisk();
   CPPUNIT_ASSERT_EQUAL(
       std::string("who knows?hello worldseconddata01234567890"),
       writer_->getString());
   CPPUNIT_ASSERT_EQUAL((size_t)0, e2.getSize());
-  CPPUNIT_ASSERT_EQUAL((size_t)0, dc.getSize());
+  CPPUNIT_ASSERT(dc.remove(&e1));
+  CPPUNIT_ASSERT(dc.remove(&e3));
 }
 
 } // namespace aria2
@@ -0,0 +1,155 @@
+#include "ZstdDecodingStreamFilter.h"
+
+#include <cassert>
+#include <iostream>
+#include <fstream>
+
+#include <zstd.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Exception.h"
+#include "util.h"
+#include "fmt.h"
+#include "Segment.h"
+#include "ByteArrayDiskWriter.h"
+#include "SinkStreamFilter.h"
+#include "ChunkedDecodingStreamFilter.h"
+#include "MockSegment.h"
+#include "MessageDigest.h"
+
+namespace aria2 {
+
+class ZstdDecodingStreamFilterTest : public CppUnit::TestFixture {
+
+  CPPUNIT_TEST_SUITE(ZstdDecodingStreamFilterTest);
+  CPPUNIT_TEST(testTransform);
+  CPPUNIT_TEST(testTransform_multiFrame);
+  CPPUNIT_TEST(testTransform_multiFrameChunked);
+  CPPUNIT_TEST_SUITE_END();
+
+  class MockSegment2 : public MockSegment {
+  private:
+    int64_t positionToWrite_;
+
+  public:
+    MockSegment2() : positionToWrite_(0) {}
+
+    virtual void updateWrittenLength(int64_t bytes) CXX11_OVERRIDE
+    {
+      positionToWrite_ += bytes;
+    }
+
+    virtual int64_t getPositionToWrite() const CXX11_OVERRIDE
+    {
+      return positionToWrite_;
+    }
+  };
+
+  std::unique_ptr<ZstdDecodingStreamFilter> filter_;
+  std::shared_ptr<ByteArrayDiskWriter> writer_;
+  std::shared_ptr<MockSegment2> segment_;
+
+public:
+  void setUp()
+  {
+    writer_ = std::make_shared<ByteArrayDiskWriter>();
+    auto sinkFilter = make_unique<SinkStreamFilter>();
+    sinkFilter->init();
+    filter_ = make_unique<ZstdDecodingStreamFilter>(std::move(sinkFilter));
+    filter_->init();
+    segment_ = std::make_shared<MockSegment2>();
+  }
+
+  void testTransform();
+  void testTransform_multiFrame();
+  void testTransform_multiFrameChunked();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ZstdDecodingStreamFilterTest);
+
+void ZstdDecodingStreamFilterTest::testTransform()
+{
+  unsigned char buf[4_k];
+  std::ifstream in(A2_TEST_DIR "/zstd_decode_test.zst", std::ios::binary);
+  while (in) {
+    in.read(reinterpret_cast<char*>(buf), sizeof(buf));
+    filter_->transform(writer_, segment_, buf, in.gcount());
+  }
+  CPPUNIT_ASSERT(filter_->finished());
+  std::string data = writer_->getString();
+  std::shared_ptr<MessageDigest> sha1(MessageDigest::sha1());
+  sha1->update(data.data(), data.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("8b577b33c0411b2be9d4fa74c7402d54a8d21f96"),
+                       util::toHex(sha1->digest()));
+}
+
+namespace {
+std::string compress(const std::string& src)
+{
+  std::string dst(ZSTD_compressBound(src.size()), '\0');
+  auto len = ZSTD_compress(&dst[0], dst.size(), src.data(), src.size(), 3);
+  assert(!ZSTD_isError(len));
+  dst.resize(len);
+  return dst;
+}
+
+std::string chunk(const std::string& data)
+{
+  return fmt("%lx\r\n", static_cast<unsigned long>(data.size())) + data +
+         "\r\n";
+}
+} // namespace
+
+void ZstdDecodingStreamFilterTest::testTransform_multiFrame()
+{
+  auto frame1 = compress("alpha");
+  auto frame2 = compress("bravo");
+  auto sinkFilter = make_unique<SinkStreamFilter>();
+  sinkFilter->init();
+  filter_ = make_unique<ZstdDecodingStreamFilter>(
+      std::move(sinkFilter), frame1.size() + frame2.size());
+  filter_->init();
+
+  // The input is split exactly at the frame boundary.  The end of the
+  // first frame is not the end of the input.
+  filter_->transform(writer_, segment_,
+                     reinterpret_cast<const unsigned char*>(frame1.data()),
+                     frame1.size());
+  CPPUNIT_ASSERT_EQUAL(frame1.size(), filter_->getBytesProcessed());
+  CPPUNIT_ASSERT(!filter_->finished());
+
+  filter_->transform(writer_, segment_,
+                     reinterpret_cast<const unsigned char*>(frame2.data()),
+                     frame2.size());
+  CPPUNIT_ASSERT(filter_->finished());
+  CPPUNIT_ASSERT_EQUAL(std::string("alphabravo"), writer_->getString());
+}
+
+void ZstdDecodingStreamFilterTest::testTransform_multiFrameChunked()
+{
+  auto sinkFilter = make_unique<SinkStreamFilter>();
+  sinkFilter->init();
+  auto zstdFilter =
+      make_unique<ZstdDecodingStreamFilter>(std::move(sinkFilter));
+  zstdFilter->init();
+  ChunkedDecodingStreamFilter filter(std::move(zstdFilter));
+  filter.init();
+
+  // The length of the input is unknown.  The end of the last chunk
+  // tells the end of the input.
+  auto data = chunk(compress("alpha"));
+  filter.transform(writer_, segment_,
+                   reinterpret_cast<const unsigned char*>(data.data()),
+                   data.size());
+  CPPUNIT_ASSERT(!filter.finished());
+
+  data = chunk(compress("bravo")) + "0\r\n\r\n";
+  filter.transform(writer_, segment_,
+                   reinterpret_cast<const unsigned char*>(data.data()),
+                   data.size());
+  CPPUNIT_ASSERT(filter.finished());
+  CPPUNIT_ASSERT_EQUAL(std::string("alphabravo"), writer_->getString());
+}
+
+} // namespace aria2
@@ -1,5 +1,8 @@
 #include "bitfield.h"
 
+#include <vector>
+#include <iterator>
+
 #include <cppunit/extensions/HelperMacros.h>
 
 #include "TimerA2.h"
@@ -13,6 +16,8 @@ class bitfieldTest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testCountBit32);
   CPPUNIT_TEST(testCountSetBit);
   CPPUNIT_TEST(testLastByteMask);
+  CPPUNIT_TEST(testGetFirstSetBitIndex);
+  CPPUNIT_TEST(testGetFirstNSetBitIndex);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -21,6 +26,8 @@ public:
   void testCountBit32();
   void testCountSetBit();
   void testLastByteMask();
+  void testGetFirstSetBitIndex();
+  void testGetFirstNSetBitIndex();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(bitfieldTest);
@@ -71,4 +78,38 @@ void bitfieldTest::testLastByteMask()
                        (unsigned int)bitfield::lastByteMask(16));
 }
 
+void bitfieldTest::testGetFirstSetBitIndex()
+{
+  unsigned char bitfield[] = {0x00, 0x00, 0x10, 0x01};
+  size_t index;
+  CPPUNIT_ASSERT(bitfield::getFirstSetBitIndex(index, bitfield, 32));
+  CPPUNIT_ASSERT_EQUAL((size_t)19, index);
+  CPPUNIT_ASSERT(bitfield::getFirstSetBitIndex(index, bitfield, 20));
+  CPPUNIT_ASSERT_EQUAL((size_t)19, index);
+  // Bits beyond nbits are ignored.
+  CPPUNIT_ASSERT(!bitfield::getFirstSetBitIndex(index, bitfield, 19));
+  CPPUNIT_ASSERT(!bitfield::getFirstSetBitIndex(index, bitfield, 0));
+}
+
+void bitfieldTest::testGetFirstNSetBitIndex()
+{
+  unsigned char bitfield[] = {0x80, 0x00, 0x13, 0x01};
+  std::vector<size_t> out;
+  CPPUNIT_ASSERT_EQUAL((size_t)4,
+                       bitfield::getFirstNSetBitIndex(std::back_inserter(out),
+                                                      10, bitfield, 31));
+  CPPUNIT_ASSERT_EQUAL((size_t)4, out.size());
+  CPPUNIT_ASSERT_EQUAL((size_t)0, out[0]);
+  CPPUNIT_ASSERT_EQUAL((size_t)19, out[1]);
+  CPPUNIT_ASSERT_EQUAL((size_t)22, out[2]);
+  CPPUNIT_ASSERT_EQUAL((size_t)23, out[3]);
+
+  out.clear();
+  CPPUNIT_ASSERT_EQUAL((size_t)2,
+                       bitfield::getFirstNSetBitIndex(std::back_inserter(out),
+                                                      2, bitfield, 32));
+  CPPUNIT_ASSERT_EQUAL((size_t)2, out.size());
+  CPPUNIT_ASSERT_EQUAL((size_t)19, out[1]);
+}
+
 } // namespace aria2